@@ -91,6 +91,7 @@ public class GetModel : ModuleRules
                 "MeshMergeUtilities",
                 "MeshUtilitiesCommon",
                 "EditorStyle",
+                "ImageWrapper",
             }
         );
 
@@ -24,7 +24,20 @@
 #include "Exporters/Exporter.h"
 #include "Framework/MultiBox/MultiBoxBuilder.h"
 #include "GetModelCommands.h"
+#include "GetModelExportJob.h"
+#include "GetModelExportManifest.h"
+#include "GetModelExportReport.h"
+#include "GetModelExportSettings.h"
+#include "GetModelExporterRegistry.h"
+#include "GetModelGltfWriter.h"
+#include "GetModelInstanceTable.h"
+#include "GetModelLandscapeExport.h"
+#include "GetModelObjWriter.h"
 #include "GetModelStyle.h"
+#include "GetModelTextureEncoder.h"
+#include "GetModelUVTransfer.h"
+#include "GetModelVertexTransform.h"
+#include "GetModelVertexWelder.h"
 #include "HierarchicalLODUtilitiesModule.h"
 #include "HierarchicalLODVolume.h"
 #include "IContentBrowserSingleton.h"
@@ -45,6 +58,7 @@
 #include "MaterialBaking/Public/MaterialOptions.h"
 #include "MaterialUtilities/Public/MaterialUtilities.h"
 #include "Materials/Material.h"
+#include "Materials/MaterialInstance.h"
 #include "Math/TransformNonVectorized.h"
 #include "MeshAttributeArray.h"
 #include "MeshAttributes.h"
@@ -56,11 +70,14 @@
 #include "MeshUtilities.h"
 #include "Misc/FileHelper.h"
 #include "Misc/PackageName.h"
+#include "Misc/ScopeExit.h"
+#include "Misc/SecureHash.h"
 #include "Misc/ScopedSlowTask.h"
 #include "Modules/ModuleManager.h"
 #include "ObjectTools.h"
 #include "PhysicsEngine/BodySetup.h"
 #include "PhysicsEngine/ConvexElem.h"
+#include "ProfilingDebugging/ScopedTimers.h"
 #include "Private/MeshMergeHelpers.h"
 #include "Private/ProxyGenerationProcessor.h"
 #include "Private/ProxyMaterialUtilities.h"
@@ -73,6 +90,7 @@
 #include "SkeletalRenderPublic.h"
 #include "StaticMeshAdapter.h"
 #include "StaticMeshComponentAdapter.h"
+#include "StaticMeshResources.h"
 #include "Transform.h"
 #include "UObject/Object.h"
 #include "UObject/Package.h"
@@ -80,6 +98,7 @@
 #include "UObjectGlobals.h"
 #include "UnrealEd.h"
 #include "Widgets/Docking/SDockTab.h"
+#include "Widgets/Input/SComboBox.h"
 #include "Widgets/Layout/SBox.h"
 #include "Widgets/Text/STextBlock.h"
 #include "widgets/Input/SButton.h"
@@ -88,8 +107,27 @@ static const FName FGetModelModuleTabName("GetModel");
 
 #define LOCTEXT_NAMESPACE "FGetModelModule"
 
+DEFINE_LOG_CATEGORY(LogGetModel);
+
+DECLARE_CYCLE_STAT(TEXT("Gather Components"), STAT_GetModel_GatherComponents, STATGROUP_GetModel);
+DECLARE_CYCLE_STAT(TEXT("Hash Inputs"), STAT_GetModel_Hash, STATGROUP_GetModel);
+DECLARE_CYCLE_STAT(TEXT("Merge And Bake"), STAT_GetModel_Merge, STATGROUP_GetModel);
+DECLARE_CYCLE_STAT(TEXT("Gather Maps"), STAT_GetModel_GatherMaps, STATGROUP_GetModel);
+DECLARE_CYCLE_STAT(TEXT("Snapshot Mesh"), STAT_GetModel_Snapshot, STATGROUP_GetModel);
+DECLARE_CYCLE_STAT(TEXT("Export Glb"), STAT_GetModel_ExportGlb, STATGROUP_GetModel);
+
 TSharedPtr<SSpinBox<int32>> TextureSizeX;
 TSharedPtr<SSpinBox<int32>> TextureSizeY;
+TSharedPtr<SSpinBox<float>> LODTextureScale;
+TSharedPtr<SSpinBox<int32>> MinLODTextureSize;
+TSharedPtr<SSpinBox<int32>> ObjFloatPrecision;
+TSharedPtr<SSpinBox<int32>> QuantizedNormalBits;
+TSharedPtr<SSpinBox<float>> WeldEpsilon;
+TSharedPtr<SSpinBox<int32>> BakeLOD;
+TSharedPtr<SSpinBox<int32>> BatchSize;
+TSharedPtr<SSpinBox<float>> BatchDistance;
+TSharedPtr<SSpinBox<float>> TileSize;
+TSharedPtr<SSpinBox<int32>> LandscapeLOD;
 
 TSharedPtr<SCheckBox> bUseVertexDataForBakingMaterial;
 TSharedPtr<SCheckBox> bMergeMaterials;
@@ -99,13 +137,369 @@ TSharedPtr<SCheckBox> bMRSMap;
 TSharedPtr<SCheckBox> bOpacityMap;
 TSharedPtr<SCheckBox> bEmissiveMap;
 TSharedPtr<SCheckBox> bInstancingMultiActors;
+TSharedPtr<SCheckBox> bWeldVertices;
+TSharedPtr<SCheckBox> bOptimizeVertexCache;
+TSharedPtr<SCheckBox> bOptimizeOverdraw;
+TSharedPtr<SCheckBox> bSkipUnchanged;
+TSharedPtr<SCheckBox> bShareBakedMaps;
+TSharedPtr<SCheckBox> bBatchMerge;
+TSharedPtr<SCheckBox> bTransientMerge;
+TSharedPtr<SCheckBox> bFastGeometry;
+TSharedPtr<SCheckBox> bInstanceTables;
+TSharedPtr<SCheckBox> bExpandInstances;
+TSharedPtr<SCheckBox> bExportLandscapes;
+TSharedPtr<SCheckBox> bLandscapeWeightmaps;
 TMap<FString, int32>  InstancedMultiActors;
 
+TArray<TSharedPtr<FString>>                TextureFormatOptions;
+TSharedPtr<SComboBox<TSharedPtr<FString>>> TextureFormat;
+TSharedPtr<SComboBox<TSharedPtr<FString>>> NormalMapFormat;
+
 inline FString FixupMaterialName(UMaterialInterface* Material)
 {
     return Material->GetName().Replace(TEXT("."), TEXT("_")).Replace(TEXT(":"), TEXT("_"));
 }
 
+inline EGetModelTextureFormat GetSelectedTextureFormat(const TSharedPtr<SComboBox<TSharedPtr<FString>>>& FormatCombo)
+{
+    const int32 Index = TextureFormatOptions.IndexOfByKey(FormatCombo->GetSelectedItem());
+    return Index == INDEX_NONE ? EGetModelTextureFormat::BMP : (EGetModelTextureFormat)Index;
+}
+
+inline TSharedRef<SWidget> MakeTextureFormatCombo(TSharedPtr<SComboBox<TSharedPtr<FString>>>& OutFormatCombo, EGetModelTextureFormat InitialFormat)
+{
+    if (TextureFormatOptions.Num() == 0) {
+        for (const FString& Name : GetTextureFormatNames()) {
+            TextureFormatOptions.Add(MakeShareable(new FString(Name)));
+        }
+    }
+
+    TSharedPtr<SComboBox<TSharedPtr<FString>>>* FormatCombo = &OutFormatCombo;
+    return SAssignNew(OutFormatCombo, SComboBox<TSharedPtr<FString>>)
+        .OptionsSource(&TextureFormatOptions)
+        .InitiallySelectedItem(TextureFormatOptions[(int32)InitialFormat])
+        .OnGenerateWidget_Lambda([](TSharedPtr<FString> Item) -> TSharedRef<SWidget> { return SNew(STextBlock).Text(FText::FromString(*Item)); })
+            [SNew(STextBlock).Text_Lambda([FormatCombo]() {
+                TSharedPtr<FString> Selected = (*FormatCombo)->GetSelectedItem();
+                return FText::FromString(Selected.IsValid() ? *Selected : FString());
+            })];
+}
+
+inline FGetModelExportSettings GetWidgetExportSettings()
+{
+    FGetModelExportSettings Settings;
+    Settings.TextureSize                     = FIntPoint(TextureSizeX->GetValue(), TextureSizeY->GetValue());
+    Settings.LODTextureScale                 = LODTextureScale->GetValue();
+    Settings.MinLODTextureSize               = MinLODTextureSize->GetValue();
+    Settings.bUseVertexDataForBakingMaterial = bUseVertexDataForBakingMaterial->IsChecked();
+    Settings.bMergePhysicsData               = bMergePhysicsData->IsChecked();
+    Settings.bNormalMap                      = bNormalMap->IsChecked();
+    Settings.bMRSMap                         = bMRSMap->IsChecked();
+    Settings.bOpacityMap                     = bOpacityMap->IsChecked();
+    Settings.bEmissiveMap                    = bEmissiveMap->IsChecked();
+    Settings.TextureFormat                   = GetSelectedTextureFormat(TextureFormat);
+    Settings.NormalMapFormat                 = GetSelectedTextureFormat(NormalMapFormat);
+    Settings.FloatPrecision                  = ObjFloatPrecision->GetValue();
+    Settings.bWeldVertices                   = bWeldVertices->IsChecked();
+    Settings.WeldEpsilon                     = WeldEpsilon->GetValue();
+    Settings.bOptimizeVertexCache            = bOptimizeVertexCache->IsChecked();
+    Settings.bOptimizeOverdraw               = bOptimizeOverdraw->IsChecked();
+    Settings.QuantizedNormalBits             = QuantizedNormalBits->GetValue();
+    Settings.bInstancingMultiActors          = bInstancingMultiActors->IsChecked();
+    Settings.bSkipUnchanged                  = bSkipUnchanged->IsChecked();
+    Settings.bShareBakedMaps                 = bShareBakedMaps->IsChecked();
+    Settings.BakeLOD                         = BakeLOD->GetValue();
+    Settings.bBatchMerge                     = bBatchMerge->IsChecked();
+    Settings.BatchSize                       = BatchSize->GetValue();
+    Settings.BatchDistance                   = BatchDistance->GetValue();
+    Settings.TileSize                        = TileSize->GetValue();
+    Settings.bTransientMerge                 = bTransientMerge->IsChecked();
+    Settings.bFastGeometry                   = bFastGeometry->IsChecked();
+    Settings.bInstanceTables                 = bInstanceTables->IsChecked();
+    Settings.bExpandInstances                = bExpandInstances->IsChecked();
+    Settings.bExportLandscapes               = bExportLandscapes->IsChecked();
+    Settings.LandscapeLOD                    = LandscapeLOD->GetValue();
+    Settings.bLandscapeWeightmaps            = bLandscapeWeightmaps->IsChecked();
+    return Settings;
+}
+
+// The file a merged LOD is written to: ObjPath itself, or ObjPath with the extension of Format.
+inline FString GetMeshPath(const FString& ObjPath, EGetModelExportFormat Format)
+{
+    switch (Format) {
+        case EGetModelExportFormat::Glb:
+            return FPaths::ChangeExtension(ObjPath, TEXT("glb"));
+        case EGetModelExportFormat::Gmq:
+            return FPaths::ChangeExtension(ObjPath, TEXT("gmq"));
+        default:
+            return ObjPath;
+    }
+}
+
+// Baked maps are named <Mesh>_<Type>, e.g. "M_Chair_LOD0_Diffuse".
+inline FString GetBakedMapType(const UObject* BakedMap)
+{
+    TArray<FString> ParsedName;
+    BakedMap->GetName().ParseIntoArray(ParsedName, TEXT("_"), true);
+    return ParsedName.Num() ? ParsedName.Last() : FString();
+}
+
+// Baked map size of one LOD: TextureSize scaled by LODTextureScale once per LOD, not below MinLODTextureSize unless
+// TextureSize itself is.
+inline FIntPoint GetLODTextureSize(const FGetModelExportSettings& Settings, int32 LOD_index)
+{
+    const float Scale = FMath::Pow(Settings.LODTextureScale, LOD_index);
+    auto        Side  = [&Settings, Scale](int32 Size) { return FMath::Min(Size, FMath::Max(Settings.MinLODTextureSize, FMath::RoundToInt(Size * Scale))); };
+    return FIntPoint(Side(Settings.TextureSize.X), Side(Settings.TextureSize.Y));
+}
+
+// Groups static mesh components for batched merging. Each batch starts at the first component left and takes the
+// closest remaining ones within MaxDistance (any distance when 0), up to GroupSize; the rest merge on their own, as do
+// instanced components when bKeepInstancedApart.
+inline TArray<TArray<UPrimitiveComponent*>> MakeMergeBatches(const TArray<UPrimitiveComponent*>& Components, int32 GroupSize, float MaxDistance, bool bKeepInstancedApart)
+{
+    TArray<TArray<UPrimitiveComponent*>> Batches;
+    TArray<UPrimitiveComponent*>         Remaining;
+    for (UPrimitiveComponent* Component : Components) {
+        if (GroupSize > 1 && Cast<UStaticMeshComponent>(Component) && !(bKeepInstancedApart && Cast<UInstancedStaticMeshComponent>(Component))) {
+            Remaining.Add(Component);
+        } else {
+            Batches.Add({Component});
+        }
+    }
+
+    while (Remaining.Num()) {
+        UPrimitiveComponent* Seed         = Remaining[0];
+        const FVector        SeedLocation = Seed->Bounds.Origin;
+        Remaining.RemoveAt(0);
+
+        Remaining.Sort([&SeedLocation](const UPrimitiveComponent& A, const UPrimitiveComponent& B) { return FVector::DistSquared(A.Bounds.Origin, SeedLocation) < FVector::DistSquared(B.Bounds.Origin, SeedLocation); });
+
+        TArray<UPrimitiveComponent*>& Batch = Batches[Batches.Add({Seed})];
+        int32                         Taken = 0;
+        while (Taken < Remaining.Num() && Batch.Num() < GroupSize && (MaxDistance <= 0.0f || FVector::Dist(Remaining[Taken]->Bounds.Origin, SeedLocation) <= MaxDistance)) {
+            Batch.Add(Remaining[Taken++]);
+        }
+        Remaining.RemoveAt(0, Taken);
+    }
+    return Batches;
+}
+
+// Splits components into TileSize squares on the ground plane by their bounds center, in row order.
+inline TArray<TArray<UPrimitiveComponent*>> MakeExportTiles(const TArray<UPrimitiveComponent*>& Components, float TileSize, TArray<FIntPoint>& OutTileCoords)
+{
+    TMap<FIntPoint, TArray<UPrimitiveComponent*>> TileMap;
+    for (UPrimitiveComponent* Component : Components) {
+        const FVector& Center = Component->Bounds.Origin;
+        TileMap.FindOrAdd(FIntPoint(FMath::FloorToInt(Center.X / TileSize), FMath::FloorToInt(Center.Y / TileSize))).Add(Component);
+    }
+    TileMap.KeySort([](const FIntPoint& A, const FIntPoint& B) { return A.Y != B.Y ? A.Y < B.Y : A.X < B.X; });
+
+    TArray<TArray<UPrimitiveComponent*>> Tiles;
+    OutTileCoords.Reset();
+    for (auto& Tile : TileMap) {
+        OutTileCoords.Add(Tile.Key);
+        Tiles.Add(MoveTemp(Tile.Value));
+    }
+    return Tiles;
+}
+
+// Drops transient merged assets whose files are written, garbage collecting them. Assets merged into the project
+// are left alone, deleting them would leave redirectors and dirty packages behind.
+inline void ReleaseMergedAssets(const TArray<UObject*>& Assets)
+{
+    bool bReleased = false;
+    for (UObject* Asset : Assets) {
+        if (Asset->GetOutermost() == GetTransientPackage()) {
+            Asset->ClearFlags(RF_Public | RF_Standalone);
+            Asset->MarkPendingKill();
+            bReleased = true;
+        }
+    }
+    if (bReleased) {
+        CollectGarbage(GARBAGE_COLLECTION_KEEPFLAGS);
+    }
+}
+
+// Stand-in for an instanced component: its mesh and materials at the origin, merged and baked once for all instances.
+// Never registered; destroy it once the export is done.
+inline UStaticMeshComponent* MakeInstanceProxy(UInstancedStaticMeshComponent* Component)
+{
+    UStaticMeshComponent* Proxy = NewObject<UStaticMeshComponent>(Component->GetOwner(), NAME_None, RF_Transient);
+    Proxy->SetStaticMesh(Component->GetStaticMesh());
+    for (int32 MaterialIndex = 0; MaterialIndex < Component->GetNumMaterials(); MaterialIndex++) {
+        Proxy->SetMaterial(MaterialIndex, Component->GetMaterial(MaterialIndex));
+    }
+    Proxy->UpdateBounds();
+    return Proxy;
+}
+
+// Obj space transform of each instance of Component, applied to its mesh merged at the origin.
+inline TArray<FMatrix> GetInstanceTransforms(UInstancedStaticMeshComponent* Component)
+{
+    const FMatrix   Swizzle = GetObjSpaceSwizzle();
+    TArray<FMatrix> Transforms;
+    Transforms.SetNumUninitialized(Component->GetInstanceCount());
+    for (int32 Instance = 0; Instance < Transforms.Num(); Instance++) {
+        FTransform InstanceToWorld;
+        Component->GetInstanceTransform(Instance, InstanceToWorld, true);
+        Transforms[Instance] = Swizzle * InstanceToWorld.ToMatrixWithScale() * Swizzle;
+    }
+    return Transforms;
+}
+
+// Components merging to the same geometry up to their transform: same static mesh, materials and LOD, and the same
+// painted vertex colors when those are baked into the maps.
+inline FString GetInstanceGroupKey(UStaticMeshComponent* Component, int32 LOD_index, bool bUseVertexData)
+{
+    FString Key = Component->GetStaticMesh()->GetPathName() + TEXT("|") + FString::FromInt(LOD_index);
+    for (int32 MaterialIndex = 0; MaterialIndex < Component->GetNumMaterials(); MaterialIndex++) {
+        UMaterialInterface* Material = Component->GetMaterial(MaterialIndex);
+        Key += TEXT("|") + (Material ? Material->GetPathName() : FString());
+    }
+
+    if (bUseVertexData && Component->LODData.IsValidIndex(LOD_index)) {
+        FColorVertexBuffer* Colors = Component->LODData[LOD_index].OverrideVertexColors;
+        if (Colors && Colors->GetNumVertices()) {
+            FSHAHash ColorHash;
+            FSHA1::HashBuffer(Colors->GetVertexData(), Colors->GetNumVertices() * Colors->GetStride(), ColorHash.Hash);
+            Key += TEXT("|") + ColorHash.ToString();
+        }
+    }
+    return Key;
+}
+
+// Merged LOD that later components of the same instance group are exported from.
+struct FGetModelInstanceSource
+{
+    TSharedPtr<FGetModelMeshSnapshot> Mesh;
+    TMap<FString, FString>            MtlEntries;
+    FTransform                        Transform;
+};
+
+// Adds what one component contributes to a merge: source render data, materials and their parameters, transform,
+// and its painted vertex colors when those are baked into the maps.
+inline void HashExportComponent(FSHA1& Sha, UStaticMeshComponent* Component, int32 LOD_index, bool bUseVertexData)
+{
+    auto UpdateString = [&Sha](const FString& Value) { Sha.UpdateWithString(*Value, Value.Len()); };
+    auto UpdateGuid   = [&Sha](const FGuid& Value) { Sha.Update((const uint8*)&Value, sizeof(FGuid)); };
+
+    // The derived data key covers the source models and build settings; hash the LOD buffers when there is none.
+    UStaticMesh* StaticMesh = Component->GetStaticMesh();
+    UpdateString(StaticMesh->GetPathName());
+    if (StaticMesh->RenderData && !StaticMesh->RenderData->DerivedDataKey.IsEmpty()) {
+        UpdateString(StaticMesh->RenderData->DerivedDataKey);
+    } else if (StaticMesh->RenderData && StaticMesh->RenderData->LODResources.IsValidIndex(LOD_index)) {
+        FStaticMeshLODResources& LODModel  = StaticMesh->RenderData->LODResources[LOD_index];
+        FPositionVertexBuffer&   Positions = LODModel.VertexBuffers.PositionVertexBuffer;
+        FStaticMeshVertexBuffer& Vertices  = LODModel.VertexBuffers.StaticMeshVertexBuffer;
+        if (Positions.GetNumVertices()) {
+            Sha.Update((const uint8*)Positions.GetVertexData(), Positions.GetNumVertices() * Positions.GetStride());
+            Sha.Update((const uint8*)Vertices.GetTangentData(), Vertices.GetTangentSize());
+            Sha.Update((const uint8*)Vertices.GetTexCoordData(), Vertices.GetTexCoordSize());
+        }
+        TArray<uint32> Indices;
+        LODModel.IndexBuffer.GetCopy(Indices);
+        Sha.Update((const uint8*)Indices.GetData(), Indices.Num() * sizeof(uint32));
+    }
+
+    for (int32 MaterialIndex = 0; MaterialIndex < Component->GetNumMaterials(); MaterialIndex++) {
+        UMaterialInterface* Material = Component->GetMaterial(MaterialIndex);
+        UpdateString(Material ? Material->GetPathName() : FString());
+
+        // Instance parameters up the parent chain, then the base material state and the textures it samples.
+        for (UMaterialInstance* Instance = Cast<UMaterialInstance>(Material); Instance; Instance = Cast<UMaterialInstance>(Instance->Parent)) {
+            for (const FScalarParameterValue& Parameter : Instance->ScalarParameterValues) {
+                UpdateString(Parameter.ParameterInfo.ToString());
+                Sha.Update((const uint8*)&Parameter.ParameterValue, sizeof(float));
+            }
+            for (const FVectorParameterValue& Parameter : Instance->VectorParameterValues) {
+                UpdateString(Parameter.ParameterInfo.ToString());
+                Sha.Update((const uint8*)&Parameter.ParameterValue, sizeof(FLinearColor));
+            }
+            for (const FTextureParameterValue& Parameter : Instance->TextureParameterValues) {
+                UpdateString(Parameter.ParameterInfo.ToString());
+                UpdateString(Parameter.ParameterValue ? Parameter.ParameterValue->GetPathName() : FString());
+            }
+
+            // Static switches and component masks pick another shader permutation without touching StateId.
+            FStaticParameterSet StaticParameters;
+            Instance->GetStaticParameterValues(StaticParameters);
+            for (const FStaticSwitchParameter& Parameter : StaticParameters.StaticSwitchParameters) {
+                UpdateString(Parameter.ParameterInfo.ToString());
+                const uint8 Value[2] = {Parameter.Value ? (uint8)1 : (uint8)0, Parameter.bOverride ? (uint8)1 : (uint8)0};
+                Sha.Update(Value, sizeof(Value));
+            }
+            for (const FStaticComponentMaskParameter& Parameter : StaticParameters.StaticComponentMaskParameters) {
+                UpdateString(Parameter.ParameterInfo.ToString());
+                const uint8 Mask[5] = {Parameter.R ? (uint8)1 : (uint8)0, Parameter.G ? (uint8)1 : (uint8)0, Parameter.B ? (uint8)1 : (uint8)0, Parameter.A ? (uint8)1 : (uint8)0, Parameter.bOverride ? (uint8)1 : (uint8)0};
+                Sha.Update(Mask, sizeof(Mask));
+            }
+        }
+
+        if (Material) {
+            if (UMaterial* BaseMaterial = Material->GetMaterial()) {
+                UpdateGuid(BaseMaterial->StateId);
+            }
+
+            TArray<UTexture*> Textures;
+            Material->GetUsedTextures(Textures, EMaterialQualityLevel::Num, true, ERHIFeatureLevel::SM5, true);
+            for (UTexture* Texture : Textures) {
+                if (Texture) {
+                    UpdateString(Texture->GetPathName());
+                    UpdateGuid(Texture->Source.GetId());
+                }
+            }
+        }
+    }
+
+    const FTransform ComponentTransform = Component->GetComponentTransform();
+    const FVector    Location           = ComponentTransform.GetLocation();
+    const FQuat      Rotation           = ComponentTransform.GetRotation();
+    const FVector    Scale              = ComponentTransform.GetScale3D();
+    Sha.Update((const uint8*)&Location, sizeof(FVector));
+    Sha.Update((const uint8*)&Rotation, sizeof(FQuat));
+    Sha.Update((const uint8*)&Scale, sizeof(FVector));
+
+    if (UInstancedStaticMeshComponent* InstancedComponent = Cast<UInstancedStaticMeshComponent>(Component)) {
+        Sha.Update((const uint8*)InstancedComponent->PerInstanceSMData.GetData(), InstancedComponent->PerInstanceSMData.Num() * sizeof(FInstancedStaticMeshInstanceData));
+    }
+
+    if (bUseVertexData && Component->LODData.IsValidIndex(LOD_index)) {
+        FColorVertexBuffer* Colors = Component->LODData[LOD_index].OverrideVertexColors;
+        if (Colors && Colors->GetNumVertices()) {
+            Sha.Update((const uint8*)Colors->GetVertexData(), Colors->GetNumVertices() * Colors->GetStride());
+        }
+    }
+}
+
+// Hashes everything one exported LOD depends on: the merged components and the merge and export settings. Bump the
+// version string when the output of the exporter changes.
+inline FString ComputeExportHash(const TArray<UPrimitiveComponent*>& Components, int32 LOD_index, const FMeshMergingSettings& Settings, const FString& ExportOptions)
+{
+    FSHA1 Sha;
+    auto  UpdateString = [&Sha](const FString& Value) { Sha.UpdateWithString(*Value, Value.Len()); };
+
+    UpdateString(TEXT("GetModelExport1"));
+    UpdateString(ExportOptions);
+    Sha.Update((const uint8*)&LOD_index, sizeof(LOD_index));
+
+    for (UPrimitiveComponent* Component : Components) {
+        if (UStaticMeshComponent* StaticMeshComponent = Cast<UStaticMeshComponent>(Component)) {
+            HashExportComponent(Sha, StaticMeshComponent, LOD_index, Settings.bUseVertexDataForBakingMaterial);
+        }
+    }
+
+    FString SettingsText;
+    FMeshMergingSettings::StaticStruct()->ExportText(SettingsText, &Settings, nullptr, nullptr, PPF_None, nullptr);
+    UpdateString(SettingsText);
+
+    uint8 Hash[FSHA1::DigestSize];
+    Sha.Final();
+    Sha.GetHash(Hash);
+    return BytesToHex(Hash, FSHA1::DigestSize);
+}
+
 void FGetModelModule::StartupModule()
 {
     // This code will execute after your module is loaded into memory; the exact timing is specified in the .uplugin file per-module.
@@ -114,6 +508,10 @@ void FGetModelModule::StartupModule()
 
     FGetModelCommands::Register();
 
+    // Exporters are instantiated once here and only re-scanned after another module loads.
+    ExporterRegistry = MakeShareable(new FGetModelExporterRegistry);
+    ExporterRegistry->Rebuild();
+
     PluginCommands = MakeShareable(new FUICommandList);
 
     PluginCommands->MapAction(
@@ -149,6 +547,8 @@ void FGetModelModule::ShutdownModule()
     FGetModelCommands::Unregister();
 
     FGlobalTabmanager::Get()->UnregisterNomadTabSpawner(FGetModelModuleTabName);
+
+    ExporterRegistry.Reset();
 }
 
 FReply FGetModelModule::GenerateMergeObj()
@@ -163,77 +563,298 @@ FReply FGetModelModule::ExportMergeObj()
     return FReply::Handled();
 }
 
-void FGetModelModule::GetObjandMaterialMethod(bool bExport)
+FReply FGetModelModule::ExportMergeGlb()
+{
+    GetObjandMaterialMethod(true, EGetModelExportFormat::Glb);
+    return FReply::Handled();
+}
+
+FReply FGetModelModule::ExportMergeGmq()
+{
+    GetObjandMaterialMethod(true, EGetModelExportFormat::Gmq);
+    return FReply::Handled();
+}
+
+void FGetModelModule::GetObjandMaterialMethod(bool bExport, EGetModelExportFormat Format)
+{
+    FGetModelExportSettings Settings = GetWidgetExportSettings();
+    Settings.bExport                 = bExport;
+    Settings.Format                  = Format;
+
+    TArray<AActor*> Actors;
+    USelection*     SelectedActors = GEditor->GetSelectedActors();
+    for (FSelectionIterator Iter(*SelectedActors); Iter; ++Iter) {
+        AActor* Actor = Cast<AActor>(*Iter);
+        if (Actor) {
+            Actors.Add(Actor);
+        }
+    }
+
+    ExportActors(Actors, Settings);
+}
+
+void FGetModelModule::ExportActors(TArray<AActor*> Actors, const FGetModelExportSettings& Settings)
 {
-    TArray<AActor*>              Actors;
     TArray<UPrimitiveComponent*> Components;
+    TArray<ALandscapeProxy*>     Landscapes;
 
-    GWarn->BeginSlowTask(NSLOCTEXT("UnrealEd", "ExportingOBJandMaterial", "Exporting Material and OBJ"), true);
+    GWarn->BeginSlowTask(NSLOCTEXT("UnrealEd", "ExportingOBJandMaterial", "Exporting Material and OBJ"), !Settings.bUnattended);
 
     {
-        USelection* SelectedActors = GEditor->GetSelectedActors();
-        for (FSelectionIterator Iter(*SelectedActors); Iter; ++Iter) {
-            AActor* Actor = Cast<AActor>(*Iter);
-            if (Actor) {
-                Actors.Add(Actor);
+        SCOPE_CYCLE_COUNTER(STAT_GetModel_GatherComponents);
+
+        // Retrieve static mesh components from the actors.
+        // SelectedComponents.Empty();
+        for (int32 ActorIndex = 0; ActorIndex < Actors.Num(); ++ActorIndex) {
+            AActor* Actor = Actors[ActorIndex];
+            check(Actor != nullptr);
+
+            TArray<UChildActorComponent*> ChildActorComponents;
+            Actor->GetComponents<UChildActorComponent>(ChildActorComponents);
+            for (UChildActorComponent* ChildComponent : ChildActorComponents) {
+                // Push actor at the back of array so we will process it.
+                AActor* ChildActor = ChildComponent->GetChildActor();
+                if (ChildActor) {
+                    Actors.Add(ChildActor);
+                }
             }
-        }
 
-        {
-            // Retrieve static mesh components from selected actors.
-            // SelectedComponents.Empty();
-            for (int32 ActorIndex = 0; ActorIndex < Actors.Num(); ++ActorIndex) {
-                AActor* Actor = Actors[ActorIndex];
-                check(Actor != nullptr);
-
-                TArray<UChildActorComponent*> ChildActorComponents;
-                Actor->GetComponents<UChildActorComponent>(ChildActorComponents);
-                for (UChildActorComponent* ChildComponent : ChildActorComponents) {
-                    // Push actor at the back of array so we will process it.
-                    AActor* ChildActor = ChildComponent->GetChildActor();
-                    if (ChildActor) {
-                        Actors.Add(ChildActor);
-                    }
+            if (ALandscapeProxy* Landscape = Cast<ALandscapeProxy>(Actor)) {
+                Landscapes.Add(Landscape);
+            }
+
+            TArray<UPrimitiveComponent*> PrimComponents;
+            Actor->GetComponents<UPrimitiveComponent>(PrimComponents);
+            for (UPrimitiveComponent* PrimComponent : PrimComponents) {
+                UStaticMeshComponent* MeshComponent = Cast<UStaticMeshComponent>(PrimComponent);
+                if (MeshComponent &&
+                    MeshComponent->GetStaticMesh() != nullptr &&
+                    MeshComponent->GetStaticMesh()->GetSourceModels().Num() > 0) {
+                    Components.Add(MeshComponent);
                 }
 
-                TArray<UPrimitiveComponent*> PrimComponents;
-                Actor->GetComponents<UPrimitiveComponent>(PrimComponents);
-                for (UPrimitiveComponent* PrimComponent : PrimComponents) {
-                    UStaticMeshComponent* MeshComponent = Cast<UStaticMeshComponent>(PrimComponent);
-                    if (MeshComponent &&
-                        MeshComponent->GetStaticMesh() != nullptr &&
-                        MeshComponent->GetStaticMesh()->GetSourceModels().Num() > 0) {
-                        Components.Add(MeshComponent);
-                    }
+                UShapeComponent* ShapeComponent = Cast<UShapeComponent>(PrimComponent);
+                if (ShapeComponent) {
+                    Components.Add(ShapeComponent);
+                }
+            }
+        }
+    }
 
-                    UShapeComponent* ShapeComponent = Cast<UShapeComponent>(PrimComponent);
-                    if (ShapeComponent) {
-                        Components.Add(ShapeComponent);
-                    }
+    // A tiled export merges, writes and releases one tile at a time, so the merged assets of a single tile are alive
+    // at any point however large the selection is. Its merges are transient: project assets would be synced to the
+    // content browser only to be deleted again.
+    int32 SkippedCount = 0;
+    if (Settings.TileSize > 0.0f) {
+        const FString                              SavePath = Settings.GetSavePath();
+        TArray<FIntPoint>                          TileCoords;
+        const TArray<TArray<UPrimitiveComponent*>> Tiles = MakeExportTiles(Components, Settings.TileSize, TileCoords);
+        for (int32 TileIndex = 0; TileIndex < Tiles.Num(); TileIndex++) {
+            FGetModelExportSettings TileSettings = Settings;
+            TileSettings.OutputDir               = SavePath + FString::Printf(TEXT("Tile_%d_%d/"), TileCoords[TileIndex].X, TileCoords[TileIndex].Y);
+            TileSettings.bTransientMerge         = Settings.bExport;
+
+            TArray<UObject*> MergedAssets;
+            SkippedCount += ExportComponents(Tiles[TileIndex], TileSettings, Settings.bExport ? &MergedAssets : nullptr);
+            ReleaseMergedAssets(MergedAssets);
+        }
+    } else {
+        SkippedCount = ExportComponents(Components, Settings);
+    }
+
+    // Landscapes are not merged: each one streams into its own obj, a wave of components at a time. Bitmaps go
+    // through the engine's exporter, so weightmaps are written as png instead.
+    if (Settings.bExport && Settings.bExportLandscapes) {
+        FGetModelLandscapeSettings LandscapeSettings;
+        LandscapeSettings.LOD             = Settings.LandscapeLOD;
+        LandscapeSettings.FloatPrecision  = Settings.FloatPrecision;
+        LandscapeSettings.bWeightmaps     = Settings.bLandscapeWeightmaps;
+        LandscapeSettings.WeightmapFormat = Settings.TextureFormat == EGetModelTextureFormat::BMP ? EGetModelTextureFormat::PNG : Settings.TextureFormat;
+        for (ALandscapeProxy* Landscape : Landscapes) {
+            const FString        ObjPath = Settings.GetSavePath() + Landscape->GetName() + TEXT("_LOD") + FString::FromInt(Settings.LandscapeLOD) + TEXT(".obj");
+            FGetModelExportStats Stats;
+            if (ExportLandscape(Landscape, ObjPath, LandscapeSettings, Stats)) {
+                UE_LOG(LogGetModel, Display, TEXT("Landscape %s: %d vertices, %d triangles, %d files written in %.2fs"), *Landscape->GetName(), Stats.Vertices, Stats.Triangles, Stats.Files.Num(), Stats.SnapshotSeconds + Stats.WriteMeshSeconds + Stats.WriteMapsSeconds + Stats.WriteMtlSeconds);
+            } else {
+                UE_LOG(LogGetModel, Warning, TEXT("Landscape %s could not be written to %s"), *Landscape->GetName(), *ObjPath);
+            }
+        }
+    }
+
+    Actors.Empty();
+    Components.Empty();
+    Landscapes.Empty();
+
+    GWarn->EndSlowTask();
+    const FString DoneMessage = SkippedCount ? FString::Printf(TEXT("Export Material and OBJ DONE, %d unchanged skipped"), SkippedCount) : FString(TEXT("Export Material and OBJ DONE"));
+    if (Settings.bUnattended) {
+        UE_LOG(LogGetModel, Display, TEXT("%s"), *DoneMessage);
+    } else {
+        FMessageDialog::Open(EAppMsgType::Ok, FText::FromString(DoneMessage));
+    }
+}
+
+int32 FGetModelModule::ExportComponents(const TArray<UPrimitiveComponent*>& Components, const FGetModelExportSettings& Settings, TArray<UObject*>* OutMergedAssets)
+{
+    FGetModelExportReport ExportReport;
+
+    const bool                  bExport = Settings.bExport;
+    const EGetModelExportFormat Format  = Settings.Format;
+
+    // Components whose inputs hash the same as on the last export, and whose files are still there, are skipped.
+    const FString           SavePath = Settings.GetSavePath();
+    FGetModelExportManifest ExportManifest(SavePath + TEXT("ExportManifest.txt"));
+    const bool              bSkipUnchangedChecked = bExport && Settings.bSkipUnchanged;
+    const FString           ExportOptions         = FString::Printf(TEXT("%d %d %d %d %d %f %d %d %d %d %d %d %d %d"), (int32)Format, (int32)Settings.TextureFormat, (int32)Settings.NormalMapFormat, Settings.FloatPrecision, Settings.bWeldVertices ? 1 : 0, Settings.WeldEpsilon, Settings.bShareBakedMaps ? 1 : 0, Settings.BakeLOD, Settings.bOptimizeVertexCache ? 1 : 0, Settings.bOptimizeOverdraw ? 1 : 0, Settings.QuantizedNormalBits, Settings.bFastGeometry ? 1 : 0, Settings.bInstanceTables ? 1 : 0, Settings.bExpandInstances ? 1 : 0);
+    int32                   SkippedCount          = 0;
+
+    // Declared after the manifest: finished jobs record into it, up to the last one the destructor waits for.
+    FGetModelExportPipeline ExportPipeline;
+
+    // Transient merges go into the transient package and never reach the asset registry or the content browser; they
+    // are released at the end unless the caller collects them. Assets merged into the project are shown in the
+    // content browser once, at the end.
+    const bool       bTransientMerge = bExport && Settings.bTransientMerge;
+    TArray<UObject*> TransientAssets;
+    TArray<UObject*> AssetsToShow;
+    if (bTransientMerge && !OutMergedAssets) {
+        OutMergedAssets = &TransientAssets;
+    }
+
+    // Without baked maps, each component's own LODs are written as they are: no merge, and the render data is read on
+    // the export workers. Glb export embeds baked maps, so it always merges.
+    const bool bFastGeometry = bExport && Settings.bFastGeometry && Format != EGetModelExportFormat::Glb;
+
+    // Instanced components (foliage, HISM) can instead be merged once at the origin and written with their instance
+    // transforms, rather than flattened into one huge merge. Glb export reads the merged asset itself, so it still
+    // flattens them.
+    const bool                    bInstanceTables = bExport && Settings.bInstanceTables && Format != EGetModelExportFormat::Glb;
+    TArray<UStaticMeshComponent*> InstanceProxies;
+
+    // With instancing, each mesh and material combination is merged and baked once; the other components of the
+    // group are written from its geometry moved by their relative transform, and share its maps. Glb export reads
+    // the merged asset itself, so it still merges every component.
+    const bool                             bReuseInstances = Settings.bInstancingMultiActors && !bFastGeometry && !(bExport && Format == EGetModelExportFormat::Glb);
+    TMap<FString, FGetModelInstanceSource> InstanceSources;
+
+    auto MakeExportJob = [&](const FString& ObjPath, const FString& MtlPath, const TSharedRef<FGetModelExportStats, ESPMode::ThreadSafe>& Stats) {
+        TSharedRef<FGetModelExportJob, ESPMode::ThreadSafe> Job = MakeShared<FGetModelExportJob, ESPMode::ThreadSafe>();
+        Job->ObjPath        = GetMeshPath(ObjPath, Format);
+        Job->MtlPath        = MtlPath;
+        Job->FloatPrecision = Settings.FloatPrecision;
+        Job->Stats          = Stats;
+        if (Format == EGetModelExportFormat::Gmq) {
+            Job->QuantizeSettings.Emplace();
+            Job->QuantizeSettings->NormalBits = Settings.QuantizedNormalBits;
+        } else if (Settings.bWeldVertices) {
+            Job->WeldSettings.Emplace();
+            Job->WeldSettings->PositionEpsilon = Settings.WeldEpsilon;
+        }
+        if (Settings.bOptimizeVertexCache) {
+            Job->OptimizeSettings.Emplace();
+            Job->OptimizeSettings->bOverdraw = Settings.bOptimizeOverdraw;
+        }
+        return Job;
+    };
+
+    auto EnqueueExportJob = [&](const TSharedRef<FGetModelExportJob, ESPMode::ThreadSafe>& Job, const FString& ExportHash) {
+        // Jobs snapshotting their own source mesh only know its sizes until they run.
+        const int32 NumVertices  = Job->SourceLOD ? Job->SourceLOD->GetNumVertices() : Job->Mesh.Positions.Num();
+        const int32 NumTriangles = Job->SourceLOD ? Job->SourceLOD->GetNumTriangles() : Job->Mesh.Indices.Num() / 3;
+
+        // Copies too many for 32 bit indices go to the table instead, decided here so the report and manifest list it.
+        if (Job->InstanceSettings.IsSet() && Job->InstanceSettings->bExpand && !CanExpandMeshInstances(NumVertices, NumTriangles, Job->InstanceSettings->Transforms.Num())) {
+            UE_LOG(LogGetModel, Warning, TEXT("%s: %d instances are too many to expand, writing an instance table"), *FPaths::GetBaseFilename(Job->ObjPath), Job->InstanceSettings->Transforms.Num());
+            Job->InstanceSettings->bExpand = false;
+        }
+
+        const bool  bHasMtl   = Job->Mesh.MaterialNames.Num() || Job->SourceMaterials.Num();
+        const bool  bHasTable = Job->InstanceSettings.IsSet() && !Job->InstanceSettings->bExpand;
+        const int32 NumCopies = Job->InstanceSettings.IsSet() && Job->InstanceSettings->bExpand ? Job->InstanceSettings->Transforms.Num() : 1;
+        if (Job->Stats.IsValid()) {
+            Job->Stats->Vertices  = NumCopies * NumVertices;
+            Job->Stats->Triangles = NumCopies * NumTriangles;
+            Job->Stats->Files.Add(Job->ObjPath);
+            if (bHasMtl) {
+                Job->Stats->Files.Add(Job->MtlPath);
+            }
+            if (bHasTable) {
+                Job->Stats->Files.Add(GetInstanceTablePath(Job->ObjPath));
+            }
+        }
+
+        if (!bSkipUnchangedChecked) {
+            ExportPipeline.Enqueue(Job);
+            return;
+        }
+
+        // Only an export whose files were all written is remembered, so a failed one is retried next time.
+        TArray<FString> Files = {Job->ObjPath};
+        if (bHasMtl) {
+            Files.Add(Job->MtlPath);
+        }
+        if (bHasTable) {
+            Files.Add(GetInstanceTablePath(Job->ObjPath));
+        }
+        for (const auto& MtlEntry : Job->Maps.MtlEntries) {
+            Files.AddUnique(SavePath + MtlEntry.Value);
+        }
+        ExportPipeline.Enqueue(Job, [&ExportManifest, ObjPath = Job->ObjPath, ExportHash, Files](bool bWritten) {
+            if (bWritten) {
+                ExportManifest.Record(ObjPath, ExportHash, Files);
+            }
+        });
+    };
+
+    // Batched components are merged together into one mesh with one atlased material.
+    TArray<TArray<UPrimitiveComponent*>> MergeBatches = MakeMergeBatches(Components, Settings.bBatchMerge && !bFastGeometry ? Settings.BatchSize : 1, Settings.BatchDistance, bInstanceTables);
+
+    // An instance source is dropped once the last component of its group is done, so only groups still in progress
+    // hold a snapshot. Without batches the components are ordered mesh by mesh, which keeps that to the variants of
+    // one mesh; the stable sort keeps the _ACTOR numbering of each mesh as it was.
+    TMap<FString, int32> InstanceGroupUses;
+    if (bReuseInstances) {
+        auto GetSortKey = [](const TArray<UPrimitiveComponent*>& Batch) {
+            UStaticMeshComponent* StaticMeshComponent = Cast<UStaticMeshComponent>(Batch[0]);
+            return StaticMeshComponent && StaticMeshComponent->GetStaticMesh() ? StaticMeshComponent->GetStaticMesh()->GetPathName() : FString();
+        };
+        if (!MergeBatches.ContainsByPredicate([](const TArray<UPrimitiveComponent*>& Batch) { return Batch.Num() > 1; })) {
+            MergeBatches.StableSort([&GetSortKey](const TArray<UPrimitiveComponent*>& A, const TArray<UPrimitiveComponent*>& B) { return GetSortKey(A) < GetSortKey(B); });
+        }
+
+        for (const TArray<UPrimitiveComponent*>& Batch : MergeBatches) {
+            UStaticMeshComponent* StaticMeshComponent = Cast<UStaticMeshComponent>(Batch[0]);
+            if (Batch.Num() == 1 && StaticMeshComponent && StaticMeshComponent->GetStaticMesh()) {
+                for (int32 LOD_index = 0; LOD_index < StaticMeshComponent->GetStaticMesh()->GetNumLODs(); LOD_index++) {
+                    InstanceGroupUses.FindOrAdd(GetInstanceGroupKey(StaticMeshComponent, LOD_index, Settings.bUseVertexDataForBakingMaterial))++;
                 }
             }
         }
     }
 
-    for (int32 Index = 0; Index < Components.Num(); Index++) {
-        GWarn->StatusUpdate(Index, Components.Num(), NSLOCTEXT("UnrealEd", "ExportingOBJandMaterial", "Exporting Material and OBJ"));
+    for (int32 Index = 0; Index < MergeBatches.Num(); Index++) {
+        GWarn->StatusUpdate(Index, MergeBatches.Num(), NSLOCTEXT("UnrealEd", "ExportingOBJandMaterial", "Exporting Material and OBJ"));
+
+        // Component to merge.
+        const TArray<UPrimitiveComponent*>& ComponentsToMerge = MergeBatches[Index];
+        const bool                          bBatch            = ComponentsToMerge.Num() > 1;
+        UPrimitiveComponent*                Component         = ComponentsToMerge[0];
 
-        UPrimitiveComponent* Component = Components[Index];
         FMeshMergingSettings settings;
-        settings.bUseVertexDataForBakingMaterial  = bUseVertexDataForBakingMaterial->IsChecked();
+        settings.bUseVertexDataForBakingMaterial  = Settings.bUseVertexDataForBakingMaterial;
         settings.LODSelectionType                 = EMeshLODSelectionType::SpecificLOD;
         settings.bMergeMaterials                  = true /*bMergeMaterials->IsChecked()*/;
-        settings.bMergePhysicsData                = bMergePhysicsData->IsChecked();
-        settings.MaterialSettings.bNormalMap      = bNormalMap->IsChecked();
-        settings.MaterialSettings.bMetallicMap    = bMRSMap->IsChecked();
-        settings.MaterialSettings.bSpecularMap    = bMRSMap->IsChecked();
-        settings.MaterialSettings.bRoughnessMap   = bMRSMap->IsChecked();
-        settings.MaterialSettings.bOpacityMap     = bOpacityMap->IsChecked();
-        settings.MaterialSettings.bOpacityMaskMap = bOpacityMap->IsChecked();
-        settings.MaterialSettings.bEmissiveMap    = bEmissiveMap->IsChecked();
+        settings.bMergePhysicsData                = Settings.bMergePhysicsData;
+        settings.MaterialSettings.bNormalMap      = Settings.bNormalMap;
+        settings.MaterialSettings.bMetallicMap    = Settings.bMRSMap;
+        settings.MaterialSettings.bSpecularMap    = Settings.bMRSMap;
+        settings.MaterialSettings.bRoughnessMap   = Settings.bMRSMap;
+        settings.MaterialSettings.bOpacityMap     = Settings.bOpacityMap;
+        settings.MaterialSettings.bOpacityMaskMap = Settings.bOpacityMap;
+        settings.MaterialSettings.bEmissiveMap    = Settings.bEmissiveMap;
         settings.bIncludeImposters                = true;
         settings.MaterialSettings.BlendMode       = BLEND_Masked;
-        settings.MaterialSettings.TextureSize     = FIntPoint(TextureSizeX->GetValue(), TextureSizeY->GetValue());
+        settings.MaterialSettings.TextureSize     = Settings.TextureSize;
         settings.bPivotPointAtZero                = false;
 
         TArray<UObject*>           AssetsToSync;
@@ -245,84 +866,315 @@ void FGetModelModule::GetObjandMaterialMethod(bool bExport)
             // Path.
             FString ProjectPath   = "/Game/GetObjandMaterial/materials/";
             FString ComponentName = FPackageName::GetShortName(Cast<UStaticMeshComponent>(Component)->GetStaticMesh()->GetOutermost()->GetName());
+            if (bBatch) {
+                ComponentName += TEXT("_BATCH") + FString::FromInt(Index);
+            }
 
             FText           T = FText::FromString(TEXT("Merging ") + ComponentName + TEXT("..."));
             FScopedSlowTask SlowTask(0, T);
-            SlowTask.MakeDialog();
+            if (!Settings.bUnattended) {
+                SlowTask.MakeDialog();
+            }
 
             UWorld* World = Component->GetWorld();
             checkf(World != nullptr, TEXT("Invalid World retrieved from Mesh components"));
             const float ScreenAreaSize = TNumericLimits<float>::Max();
 
-            // Component to merge.
-            TArray<UPrimitiveComponent*> ComponentsToMerge;
-            ComponentsToMerge.Add(Component);
-
             // Get lod.
             UStaticMeshComponent* StaticMeshComponent = Cast<UStaticMeshComponent>(Component);
-            auto                  ModelTransfom       = StaticMeshComponent->GetRelativeTransform();
 
-            int32 LOD_index;
-            for (LOD_index = 0; LOD_index < StaticMeshComponent->GetStaticMesh()->GetNumLODs(); ++LOD_index) {
+            // An instanced component is merged as its stand-in, and its instances go with every LOD written from it.
+            // Fast geometry reads the component's own mesh without merging, which would flatten the instances, so it
+            // always goes this way and expands the copies into the mesh unless instance tables are asked for.
+            UInstancedStaticMeshComponent*       InstancedComponent = bInstanceTables || bFastGeometry ? Cast<UInstancedStaticMeshComponent>(Component) : nullptr;
+            TArray<UPrimitiveComponent*>         MergeSources       = ComponentsToMerge;
+            TOptional<FGetModelInstanceSettings> InstanceSettings;
+            if (InstancedComponent) {
+                if (InstancedComponent->GetInstanceCount() == 0) {
+                    continue;
+                }
+                StaticMeshComponent = MakeInstanceProxy(InstancedComponent);
+                MergeSources        = {StaticMeshComponent};
+                InstanceProxies.Add(StaticMeshComponent);
+                InstanceSettings.Emplace();
+                InstanceSettings->Transforms = GetInstanceTransforms(InstancedComponent);
+                InstanceSettings->bExpand    = Settings.bExpandInstances || !bInstanceTables;
+                if (bInstanceTables) {
+                    ComponentName += TEXT("_INSTANCES");
+                } else {
+                    UE_LOG(LogGetModel, Log, TEXT("%s: fast geometry writes its %d instances as copies in the mesh"), *ComponentName, InstancedComponent->GetInstanceCount());
+                }
+            }
+            auto ModelTransfom = StaticMeshComponent->GetRelativeTransform();
+
+            // Components of a batch with fewer LODs contribute their last one.
+            int32 NumLODs = 0;
+            for (UPrimitiveComponent* ComponentToMerge : ComponentsToMerge) {
+                NumLODs = FMath::Max(NumLODs, Cast<UStaticMeshComponent>(ComponentToMerge)->GetStaticMesh()->GetNumLODs());
+            }
+
+            // With shared maps, only the bake LOD is merged with its materials, and it goes first. The other LODs are
+            // merged as geometry only and sample its maps through uvs transferred from its surface. Glb export embeds
+            // the maps of each merged asset, so it keeps baking every LOD.
+            const bool    bShareMaps   = Settings.bShareBakedMaps && NumLODs > 1 && !bFastGeometry && !(bExport && Format == EGetModelExportFormat::Glb);
+            const int32   BakeLODIndex = FMath::Clamp(Settings.BakeLOD, 0, NumLODs - 1);
+            TArray<int32> LODOrder;
+            for (int32 LOD_index = 0; LOD_index < NumLODs; ++LOD_index) {
+                LODOrder.Add(LOD_index);
+            }
+            if (bShareMaps) {
+                LODOrder.Remove(BakeLODIndex);
+                LODOrder.Insert(BakeLODIndex, 0);
+            }
+
+            TSharedPtr<FGetModelMeshSnapshot> BakedMesh;
+            TMap<FString, FString>            BakedMtlEntries;
+
+            // Geometry-only depends on the settings alone, so every LOD hashes the same from run to run. Shared maps
+            // also texture LOD 0, so they bake at its full size whichever LOD they are baked from.
+            auto SetLODSettings = [&](int32 LOD_index) {
+                settings.SpecificLOD                  = LOD_index;
+                settings.bMergeMaterials              = !(bShareMaps && LOD_index != BakeLODIndex);
+                settings.MaterialSettings.TextureSize = GetLODTextureSize(Settings, bShareMaps ? 0 : LOD_index);
+            };
+
+            // Output paths and hashes of every LOD come first. With shared maps the other LODs are built from the
+            // bake LOD's merge, so the LODs of a component are only skipped together, when none of them changed.
+            struct FLODExport
+            {
+                FString ObjPath;
+                FString MtlPath;
+                FString ExportHash;
+                bool    bUpToDate = false;
+            };
+            TMap<int32, FLODExport> LODExports;
+            bool                    bAllLODsUpToDate = true;
+            if (bExport) {
+                for (int32 LOD_index : LODOrder) {
+                    FLODExport& LODExport = LODExports.Add(LOD_index);
+                    FString&    ObjPath   = LODExport.ObjPath;
+                    FString&    MtlPath   = LODExport.MtlPath;
+
+                    // Instance multi actors.
+                    ObjPath = SavePath + ComponentName + TEXT("_LOD") + FString::FromInt(LOD_index) + TEXT(".obj");
+                    MtlPath = SavePath + ComponentName + TEXT("_LOD") + FString::FromInt(LOD_index) + TEXT(".mtl");
+                    if (Settings.bInstancingMultiActors) {
+                        if (auto it = InstancedMultiActors.Find(ComponentName + TEXT("_LOD") + FString::FromInt(LOD_index))) {
+                            *it += 1;
+                            ObjPath = SavePath + ComponentName + TEXT("_ACTOR") + FString::FromInt(*it) + TEXT("_LOD") + FString::FromInt(LOD_index) + TEXT(".obj");
+                            MtlPath = SavePath + ComponentName + TEXT("_ACTOR") + FString::FromInt(*it) + TEXT("_LOD") + FString::FromInt(LOD_index) + TEXT(".mtl");
+                        } else {
+                            InstancedMultiActors.Add(ComponentName + TEXT("_LOD") + FString::FromInt(LOD_index), 0);
+                            ObjPath = SavePath + ComponentName + TEXT("_ACTOR0") + TEXT("_LOD") + FString::FromInt(LOD_index) + TEXT(".obj");
+                            MtlPath = SavePath + ComponentName + TEXT("_ACTOR0") + TEXT("_LOD") + FString::FromInt(LOD_index) + TEXT(".mtl");
+                        }
+                    }
+
+                    if (bSkipUnchangedChecked) {
+                        SCOPE_CYCLE_COUNTER(STAT_GetModel_Hash);
+                        SetLODSettings(LOD_index);
+                        LODExport.ExportHash = ComputeExportHash(ComponentsToMerge, LOD_index, settings, ExportOptions);
+                        LODExport.bUpToDate  = ExportManifest.IsUpToDate(GetMeshPath(ObjPath, Format), LODExport.ExportHash);
+                    }
+                    bAllLODsUpToDate &= LODExport.bUpToDate;
+                }
+            }
+
+            for (int32 LOD_index : LODOrder) {
+                const bool bGeometryOnly = bShareMaps && LOD_index != BakeLODIndex;
+                SetLODSettings(LOD_index);
+
+                // Keyed by the component itself rather than an instance proxy, like the group sizes counted above.
+                FString InstanceKey;
+                bool    bLastOfGroup = false;
+                if (bReuseInstances && !bBatch) {
+                    InstanceKey  = GetInstanceGroupKey(Cast<UStaticMeshComponent>(Component), LOD_index, Settings.bUseVertexDataForBakingMaterial);
+                    bLastOfGroup = --InstanceGroupUses.FindOrAdd(InstanceKey) <= 0;
+                }
+                ON_SCOPE_EXIT
+                {
+                    if (bLastOfGroup) {
+                        InstanceSources.Remove(InstanceKey);
+                    }
+                };
+
+                FString                                               ObjPath;
+                FString                                               MtlPath;
+                FString                                               ExportHash;
+                TSharedRef<FGetModelExportStats, ESPMode::ThreadSafe> Stats = MakeShared<FGetModelExportStats, ESPMode::ThreadSafe>();
+                if (bExport) {
+                    const FLODExport& LODExport = LODExports.FindChecked(LOD_index);
+                    ObjPath                     = LODExport.ObjPath;
+                    MtlPath                     = LODExport.MtlPath;
+                    ExportHash                  = LODExport.ExportHash;
+
+                    Stats = ExportReport.AddRow(FPaths::GetBaseFilename(ObjPath), LOD_index, bGeometryOnly ? TEXT("shared maps") : TEXT("merged"));
+
+                    if (bShareMaps ? bAllLODsUpToDate : LODExport.bUpToDate) {
+                        Stats->Status = TEXT("unchanged");
+                        SkippedCount++;
+                        continue;
+                    }
+
+                    // The bake LOD goes first; when it could not be merged there are no maps to share.
+                    if (bGeometryOnly && !BakedMesh.IsValid()) {
+                        UE_LOG(LogGetModel, Warning, TEXT("%s skipped, its bake LOD %d was not exported"), *FPaths::GetBaseFilename(ObjPath), BakeLODIndex);
+                        Stats->Status = TEXT("no bake LOD");
+                        continue;
+                    }
+                }
+
+                if (bReuseInstances && !bBatch) {
+                    if (const FGetModelInstanceSource* Source = InstanceSources.Find(InstanceKey)) {
+                        if (bExport && Source->Mesh.IsValid()) {
+                            const FMatrix Delta = Source->Transform.ToMatrixWithScale().Inverse() * StaticMeshComponent->GetComponentTransform().ToMatrixWithScale();
+
+                            TSharedRef<FGetModelExportJob, ESPMode::ThreadSafe> Job = MakeExportJob(ObjPath, MtlPath, Stats);
+                            {
+                                SCOPE_CYCLE_COUNTER(STAT_GetModel_Snapshot);
+                                FScopedDurationTimer Timer(Stats->SnapshotSeconds);
+                                TransformMeshSnapshot(*Source->Mesh, Delta, Job->Mesh);
+                            }
+                            Job->Maps.MtlEntries  = Source->MtlEntries;
+                            Job->InstanceSettings = InstanceSettings;
+                            Stats->Status         = TEXT("instanced");
+                            if (bShareMaps && LOD_index == BakeLODIndex) {
+                                BakedMesh       = MakeShared<FGetModelMeshSnapshot>(Job->Mesh);
+                                BakedMtlEntries = Job->Maps.MtlEntries;
+                            }
+                            EnqueueExportJob(Job, ExportHash);
+                        }
+                        continue;
+                    }
+                }
+
+                if (bFastGeometry) {
+                    const FStaticMeshLODResources& RenderData = StaticMeshComponent->GetStaticMesh()->GetLODForExport(LOD_index);
+
+                    TSharedRef<FGetModelExportJob, ESPMode::ThreadSafe> Job = MakeExportJob(ObjPath, MtlPath, Stats);
+                    Job->SourceLOD                                          = &RenderData;
+                    Job->SourceToWorld                                      = StaticMeshComponent->GetComponentTransform().ToMatrixWithScale();
+                    for (const FStaticMeshSection& Section : RenderData.Sections) {
+                        UMaterialInterface* Material = StaticMeshComponent->GetMaterial(Section.MaterialIndex);
+                        Job->SourceMaterials.Add(Material ? FixupMaterialName(Material) : FString(TEXT("DefaultMaterial")));
+                    }
+                    Job->InstanceSettings = InstanceSettings;
+                    Stats->Status         = TEXT("source");
+                    EnqueueExportJob(Job, ExportHash);
+                    continue;
+                }
+
                 // Merge mesh and material.
-                settings.SpecificLOD = LOD_index;
-                MeshUtilities.MergeComponentsToStaticMesh(ComponentsToMerge, World, settings, nullptr, nullptr, ProjectPath + ComponentName + TEXT("_LOD") + FString::FromInt(LOD_index), AssetsToSync, MergedActorLocation, ScreenAreaSize, false);
+                AssetsToSync.Reset();
+                {
+                    SCOPE_CYCLE_COUNTER(STAT_GetModel_Merge);
+                    FScopedDurationTimer Timer(Stats->MergeSeconds);
+                    MeshUtilities.MergeComponentsToStaticMesh(MergeSources, World, settings, nullptr, bTransientMerge ? GetTransientPackage() : nullptr, ProjectPath + ComponentName + TEXT("_LOD") + FString::FromInt(LOD_index), AssetsToSync, MergedActorLocation, ScreenAreaSize, false);
+                }
+
+                for (UObject* Asset : AssetsToSync) {
+                    if (UTexture2D* Texture = Cast<UTexture2D>(Asset)) {
+                        Stats->TextureSizes.Add(FIntPoint(Texture->Source.GetSizeX(), Texture->Source.GetSizeY()));
+                    }
+                }
 
                 // Save
                 if (AssetsToSync.Num()) {
+                    if (OutMergedAssets) {
+                        OutMergedAssets->Append(AssetsToSync);
+                    }
+
                     // Save in project.
-                    FAssetRegistryModule& AssetRegistry = FModuleManager::Get().LoadModuleChecked<FAssetRegistryModule>("AssetRegistry");
-                    int32                 AssetCount    = AssetsToSync.Num();
-                    for (int32 AssetIndex = 0; AssetIndex < AssetCount; AssetIndex++) {
-                        AssetRegistry.AssetCreated(AssetsToSync[AssetIndex]);
-                        GEditor->BroadcastObjectReimported(AssetsToSync[AssetIndex]);
+                    if (!bTransientMerge) {
+                        FAssetRegistryModule& AssetRegistry = FModuleManager::Get().LoadModuleChecked<FAssetRegistryModule>("AssetRegistry");
+                        int32                 AssetCount    = AssetsToSync.Num();
+                        for (int32 AssetIndex = 0; AssetIndex < AssetCount; AssetIndex++) {
+                            AssetRegistry.AssetCreated(AssetsToSync[AssetIndex]);
+                            GEditor->BroadcastObjectReimported(AssetsToSync[AssetIndex]);
+                        }
+                        AssetsToShow.Append(AssetsToSync);
+                    }
+
+                    if (bReuseInstances && !bBatch && !bExport && !bLastOfGroup) {
+                        InstanceSources.Add(InstanceKey, FGetModelInstanceSource());
                     }
-                    // Also notify the content browser that the new assets exists.
-                    FContentBrowserModule& ContentBrowserModule = FModuleManager::Get().LoadModuleChecked<FContentBrowserModule>("ContentBrowser");
-                    ContentBrowserModule.Get().SyncBrowserToAssets(AssetsToSync, true);
 
                     if (bExport) {
-                        // Export maps.
-                        TMap<FString, FString> MTLs = ExportMaterialToBMP(AssetsToSync);
-
-                        // Instance multi actors.
-                        FString SavePath = FPaths::ConvertRelativePathToFull(FPaths::ProjectContentDir()) + TEXT("GetObjandMaterial/");
-                        FString ObjPath  = SavePath + ComponentName + TEXT("_LOD") + FString::FromInt(LOD_index) + TEXT(".obj");
-                        FString MtlPath  = SavePath + ComponentName + TEXT("_LOD") + FString::FromInt(LOD_index) + TEXT(".mtl");
-                        if (bInstancingMultiActors->IsChecked()) {
-                            if (auto it = InstancedMultiActors.Find(ComponentName + TEXT("_LOD") + FString::FromInt(LOD_index))) {
-                                *it += 1;
-                                ObjPath = SavePath + ComponentName + TEXT("_ACTOR") + FString::FromInt(*it) + TEXT("_LOD") + FString::FromInt(LOD_index) + TEXT(".obj");
-                                MtlPath = SavePath + ComponentName + TEXT("_ACTOR") + FString::FromInt(*it) + TEXT("_LOD") + FString::FromInt(LOD_index) + TEXT(".mtl");
-                            } else {
-                                InstancedMultiActors.Add(ComponentName + TEXT("_LOD") + FString::FromInt(LOD_index), 0);
-                                ObjPath = SavePath + ComponentName + TEXT("_ACTOR0") + TEXT("_LOD") + FString::FromInt(LOD_index) + TEXT(".obj");
-                                MtlPath = SavePath + ComponentName + TEXT("_ACTOR0") + TEXT("_LOD") + FString::FromInt(LOD_index) + TEXT(".mtl");
+                        if (Format == EGetModelExportFormat::Glb) {
+                            // Export glb, geometry and baked maps go into one binary file.
+                            UStaticMesh*  MergedMesh = nullptr;
+                            const FString GlbPath    = GetMeshPath(ObjPath, Format);
+                            if (AssetsToSync.FindItemByClass(&MergedMesh)) {
+                                bool bExported;
+                                {
+                                    SCOPE_CYCLE_COUNTER(STAT_GetModel_ExportGlb);
+                                    FScopedDurationTimer Timer(Stats->WriteMeshSeconds);
+                                    bExported = ExportGlb(MergedMesh, GlbPath, LOD_index, StaticMeshComponent, AssetsToSync);
+                                }
+
+                                const FStaticMeshLODResources& LODModel = MergedMesh->GetLODForExport(LOD_index);
+                                Stats->Vertices                         = LODModel.GetNumVertices();
+                                Stats->Triangles                        = LODModel.GetNumTriangles();
+                                Stats->Files.Add(GlbPath);
+                                if (bExported && bSkipUnchangedChecked) {
+                                    ExportManifest.Record(GlbPath, ExportHash, {GlbPath});
+                                }
                             }
+                            continue;
                         }
 
-                        // Export obj.
-                        UStaticMesh*    MergedMesh = nullptr;
-                        TArray<FString> MtlNames;
+                        // Only the UObject reads happen here; encoding and writing run in the background while the next
+                        // component is merged.
+                        UStaticMesh* MergedMesh = nullptr;
                         if (AssetsToSync.FindItemByClass(&MergedMesh)) {
-                            MtlNames = ExportObj(MergedMesh, ObjPath, LOD_index, StaticMeshComponent);
-                        }
+                            TSharedRef<FGetModelExportJob, ESPMode::ThreadSafe> Job = MakeExportJob(ObjPath, MtlPath, Stats);
+
+                            if (bGeometryOnly) {
+                                // Export obj, its mtl references the bake LOD's maps.
+                                SCOPE_CYCLE_COUNTER(STAT_GetModel_Snapshot);
+                                FScopedDurationTimer Timer(Stats->SnapshotSeconds);
+                                SnapshotMesh(MergedMesh, LOD_index, StaticMeshComponent, Job->Mesh);
+                                TransferUVs(*BakedMesh, Job->Mesh);
+                                Job->Mesh.MaterialTriangles.Reset();
+                                Job->Mesh.MaterialNames.Reset();
+                                if (Job->Mesh.Indices.Num() && BakedMesh->MaterialNames.Num()) {
+                                    Job->Mesh.MaterialTriangles.Add(0);
+                                    Job->Mesh.MaterialNames.Add(BakedMesh->MaterialNames[0]);
+                                }
+                                Job->Maps.MtlEntries = BakedMtlEntries;
+                            } else {
+                                // Export maps.
+                                {
+                                    SCOPE_CYCLE_COUNTER(STAT_GetModel_GatherMaps);
+                                    FScopedDurationTimer Timer(Stats->GatherMapsSeconds);
+                                    GatherMaterialMaps(AssetsToSync, Settings.TextureFormat, Settings.NormalMapFormat, SavePath, Job->Maps);
+                                }
+                                for (const auto& MtlEntry : Job->Maps.MtlEntries) {
+                                    Stats->Files.AddUnique(SavePath + MtlEntry.Value);
+                                }
+
+                                // Export obj and mtl.
+                                {
+                                    SCOPE_CYCLE_COUNTER(STAT_GetModel_Snapshot);
+                                    FScopedDurationTimer Timer(Stats->SnapshotSeconds);
+                                    SnapshotMesh(MergedMesh, LOD_index, StaticMeshComponent, Job->Mesh);
+                                }
+
+                                if (bShareMaps && LOD_index == BakeLODIndex) {
+                                    BakedMesh       = MakeShared<FGetModelMeshSnapshot>(Job->Mesh);
+                                    BakedMtlEntries = Job->Maps.MtlEntries;
+                                }
+                            }
 
-                        // Export mtl.
-                        // UMaterialInstanceConstant* MergedMaterial = nullptr;
-                        // if (AssetsToSync.FindItemByClass(&MergedMaterial))
-                        {
-                            FOutputDeviceFile* MaterialFile = new FOutputDeviceFile(*MtlPath, true);
-                            MaterialFile->SetSuppressEventTag(true);
-                            MaterialFile->SetAutoEmitLineTerminator(false);
-
-                            MaterialFile->Logf(TEXT("newmtl %s\r\n"), *MtlNames[0]);
-                            for (auto mtlItor = MTLs.CreateIterator(); mtlItor; ++mtlItor) {
-                                MaterialFile->Logf(TEXT("\t%s %s\r\n"), *mtlItor.Key(), *mtlItor.Value());
+                            if (bReuseInstances && !bBatch && !bLastOfGroup) {
+                                FGetModelInstanceSource& Source = InstanceSources.Add(InstanceKey);
+                                Source.Mesh                     = MakeShared<FGetModelMeshSnapshot>(Job->Mesh);
+                                Source.MtlEntries               = Job->Maps.MtlEntries;
+                                Source.Transform                = StaticMeshComponent->GetComponentTransform();
                             }
-                            MaterialFile->Logf(TEXT("\r\n\n"));
-                            MaterialFile->TearDown();
-                            delete MaterialFile;
+
+                            Job->InstanceSettings = InstanceSettings;
+                            EnqueueExportJob(Job, ExportHash);
                         }
                     }
                 }
@@ -330,130 +1182,227 @@ void FGetModelModule::GetObjandMaterialMethod(bool bExport)
         }
     }
 
-    Actors.Empty();
-    Components.Empty();
+    ExportPipeline.Flush();
 
-    InstancedMultiActors.Empty();
+    for (UStaticMeshComponent* Proxy : InstanceProxies) {
+        Proxy->DestroyComponent();
+    }
 
-    GWarn->EndSlowTask();
-    FMessageDialog::Open(EAppMsgType::Ok, FText::FromString(TEXT("Export Material and OBJ DONE")));
-}
+    if (bSkipUnchangedChecked) {
+        ExportManifest.Save();
+    }
 
-TArray<FString> FGetModelModule::ExportObj(UStaticMesh* MergedMesh, FString& ObjPath, int LOD_index, UStaticMeshComponent* StaticMeshComponent)
-{
-    TArray<FString> MtlNames;
+    if (bExport) {
+        const FString ReportPath = SavePath + TEXT("ExportReport_") + FDateTime::Now().ToString() + TEXT(".csv");
+        ExportReport.SaveCsv(ReportPath);
+        UE_LOG(LogGetModel, Display, TEXT("Export report written to %s"), *ReportPath);
+    }
 
-    FArchive* ObjFile = IFileManager::Get().CreateFileWriter(*ObjPath);
-    ObjFile->Logf(TEXT("# UnrealEd OBJ exporter\r\n"));
+    // Also notify the content browser that the new assets exists.
+    if (AssetsToShow.Num() && !Settings.bUnattended) {
+        FContentBrowserModule& ContentBrowserModule = FModuleManager::Get().LoadModuleChecked<FContentBrowserModule>("ContentBrowser");
+        ContentBrowserModule.Get().SyncBrowserToAssets(AssetsToShow, true);
+    }
 
-    TArray<FStaticMaterial>        StaticMaterials = MergedMesh->StaticMaterials;
-    const FStaticMeshLODResources& RenderData      = MergedMesh->GetLODForExport(LOD_index);
-    uint32                         VertexCount     = RenderData.GetNumVertices();
-    check(VertexCount == RenderData.VertexBuffers.StaticMeshVertexBuffer.GetNumVertices());
+    ReleaseMergedAssets(TransientAssets);
 
-    ObjFile->Logf(TEXT("\r\n"));
-    ObjFile->Logf(TEXT("mtllib %s\n"), *FPaths::GetCleanFilename(ObjPath));
+    InstancedMultiActors.Empty();
 
-    for (uint32 i = 0; i < VertexCount; i++) {
-        const FVector& OSPos = RenderData.VertexBuffers.PositionVertexBuffer.VertexPosition(i);
-        // const FVector WSPos = StaticMeshComponent->LocalToWorld.TransformPosition( OSPos );
+    return SkippedCount;
+}
 
-        FVector       Temp = OSPos;
-        const FVector WPos = StaticMeshComponent->GetComponentTransform().GetLocation() + Temp;
-        // const FVector WPos = StaticMeshComponent->GetComponentToWorld().TransformPosition(Temp);
-        // const FVector WPos = StaticMeshComponent->GetRelativeTransform().TransformVector(Temp);
+TArray<FString> FGetModelModule::ExportObj(UStaticMesh* MergedMesh, FString& ObjPath, int LOD_index, UStaticMeshComponent* StaticMeshComponent, int32 FloatPrecision, const FGetModelWeldSettings* WeldSettings)
+{
+    FGetModelMeshSnapshot Mesh;
+    SnapshotMesh(MergedMesh, LOD_index, StaticMeshComponent, Mesh);
+    WriteObjFile(Mesh, ObjPath, FloatPrecision, WeldSettings);
 
-        // Transform to Lightwave's coordinate system.
-        ObjFile->Logf(TEXT("v %f %f %f\r\n"), WPos.X, WPos.Z, WPos.Y);
-    }
-    ObjFile->Logf(TEXT("\r\n"));
+    return Mesh.MaterialNames;
+}
 
-    for (uint32 i = 0; i < VertexCount; ++i) {
-        // Takes the first UV.
-        // const FVector2D UV = RenderData.VertexBuffer.GetVertexUV(i, 0);
-        const FVector2D UV = RenderData.VertexBuffers.StaticMeshVertexBuffer.GetVertexUV(i, 0);
+void FGetModelModule::SnapshotMesh(UStaticMesh* MergedMesh, int LOD_index, UStaticMeshComponent* StaticMeshComponent, FGetModelMeshSnapshot& OutMesh)
+{
+    // Merging already applied each component's rotation and scale around the first component, only its location
+    // is left to add back.
+    SnapshotMesh(MergedMesh, LOD_index, FTranslationMatrix(StaticMeshComponent->GetComponentTransform().GetLocation()), OutMesh);
+}
 
-        // Invert the y-coordinate (Lightwave has their bitmaps upside-down from us).
-        ObjFile->Logf(TEXT("vt %f %f\r\n"), UV.X, 1.0f - UV.Y);
+void FGetModelModule::SnapshotMesh(UStaticMesh* Mesh, int LOD_index, const FMatrix& MeshToWorld, FGetModelMeshSnapshot& OutMesh)
+{
+    const TArray<FStaticMaterial>& StaticMaterials = Mesh->StaticMaterials;
+    const FStaticMeshLODResources& RenderData      = Mesh->GetLODForExport(LOD_index);
+
+    TArray<FString> SectionMaterials;
+    for (int32 count = 0; count < RenderData.Sections.Num() && count < StaticMaterials.Num(); count++) {
+        FString mtl = StaticMaterials[count].MaterialSlotName.ToString() + TEXT("_") + StaticMaterials[count].MaterialSlotName.ToString();
+        SectionMaterials.Add(FPaths::GetCleanFilename(mtl));
     }
+    SnapshotLODResources(RenderData, MeshToWorld, SectionMaterials, OutMesh);
+}
 
-    ObjFile->Logf(TEXT("\r\n"));
+bool FGetModelModule::ExportGlb(UStaticMesh* MergedMesh, const FString& GlbPath, int LOD_index, UStaticMeshComponent* StaticMeshComponent, TArray<UObject*>& BakedAssets)
+{
+    // The same snapshot as the obj export: world location and axis swap in one TransformVertices pass. glTF is
+    // right-handed Y-up like the swapped frame, so the winding stays as it is. Positions stay in Unreal units and the
+    // node scale turns them into meters.
+    const FStaticMeshLODResources& RenderData = MergedMesh->GetLODForExport(LOD_index);
+    FGetModelMeshSnapshot          Mesh;
+    SnapshotMesh(MergedMesh, LOD_index, StaticMeshComponent, Mesh);
+    const int32 VertexCount = Mesh.Positions.Num();
+
+    FGetModelGlbWriter GlbWriter;
+
+    // glTF forbids zero length views and accessors, an empty lod keeps only its materials.
+    const bool bHasGeometry = VertexCount > 0 && Mesh.Indices.Num() > 0;
+
+    int32 PositionAccessor = INDEX_NONE;
+    int32 NormalAccessor   = INDEX_NONE;
+    int32 UVAccessor       = INDEX_NONE;
+    int32 IndexView        = INDEX_NONE;
+    if (bHasGeometry) {
+        const int32 PositionView = GlbWriter.AddBufferView(Mesh.Positions.GetData(), VertexCount * sizeof(FVector), FGetModelGlbWriter::ArrayBuffer);
+        const int32 NormalView   = GlbWriter.ReserveBufferView(VertexCount * sizeof(FVector), FGetModelGlbWriter::ArrayBuffer);
+        const int32 UVView       = GlbWriter.ReserveBufferView(VertexCount * sizeof(FVector2D), FGetModelGlbWriter::ArrayBuffer);
+        FVector*    Normals      = (FVector*)GlbWriter.GetBufferViewData(NormalView);
+        FVector2D*  UVs          = (FVector2D*)GlbWriter.GetBufferViewData(UVView);
+
+        ParallelFor(VertexCount, [&](int32 i) {
+            // glTF requires unit normals, and has its uv origin top-left like Unreal, so the obj flip is undone.
+            Normals[i] = Mesh.Normals[i].IsZero() ? FVector(0.0f, 1.0f, 0.0f) : Mesh.Normals[i];
+            UVs[i]     = FVector2D(Mesh.UVs[i].X, 1.0f - Mesh.UVs[i].Y);
+        });
+
+        const FBox    Bounds(Mesh.Positions.GetData(), VertexCount);
+        const FString PositionMinMax = TEXT("\"min\":") + FGetModelGlbWriter::FormatFloats(&Bounds.Min.X, 3) + TEXT(",\"max\":") + FGetModelGlbWriter::FormatFloats(&Bounds.Max.X, 3);
+
+        PositionAccessor = GlbWriter.AddAccessor(PositionView, 0, FGetModelGlbWriter::Float, VertexCount, TEXT("VEC3"), PositionMinMax);
+        NormalAccessor   = GlbWriter.AddAccessor(NormalView, 0, FGetModelGlbWriter::Float, VertexCount, TEXT("VEC3"));
+        UVAccessor       = GlbWriter.AddAccessor(UVView, 0, FGetModelGlbWriter::Float, VertexCount, TEXT("VEC2"));
+
+        // One index view for the whole lod, each section reads its own range of it.
+        IndexView = GlbWriter.AddBufferView(Mesh.Indices.GetData(), Mesh.Indices.Num() * sizeof(uint32), FGetModelGlbWriter::ElementArrayBuffer);
+    }
 
-    for (uint32 i = 0; i < VertexCount; ++i) {
-        // const FVector& OSNormal = RenderData.VertexBuffer.VertexTangentZ(i);
-        const FVector& OSNormal = RenderData.VertexBuffers.StaticMeshVertexBuffer.VertexTangentZ(i);
-        FVector        Temp     = OSNormal;
-        // const FVector WNormal = StaticMeshComponent->GetRelativeTransform().TransformVector(Temp);
+    // Baked maps to PBR slots. Channels are rearranged where Unreal and glTF disagree:
+    // opacity goes into the base color alpha, MRS (R metallic, G roughness, B specular) becomes glTF's
+    // metallicRoughness (G roughness, B metallic), and the normal map's green is flipped from DirectX to OpenGL.
+    UTexture2D*  BakedMaps[5] = {};
+    const TCHAR* MapTypes[5]  = {TEXT("Diffuse"), TEXT("MRS"), TEXT("Normal"), TEXT("Emissive"), TEXT("OpacityMask")};
+    UTexture2D*  Opacity      = nullptr;
+    for (UObject* Asset : BakedAssets) {
+        UTexture2D* Texture = Cast<UTexture2D>(Asset);
+        if (!Texture) {
+            continue;
+        }
 
-        // Transform to Lightwave's coordinate system.
-        ObjFile->Logf(TEXT("vn %f %f %f\r\n"), Temp.X, Temp.Z, Temp.Y);
+        const FString MapType = GetBakedMapType(Texture);
+        for (int32 MapIndex = 0; MapIndex < ARRAY_COUNT(MapTypes); MapIndex++) {
+            if (MapType == MapTypes[MapIndex]) {
+                BakedMaps[MapIndex] = Texture;
+            }
+        }
+        if (MapType == TEXT("Opacity")) {
+            Opacity = Texture;
+        }
     }
 
-    TArray<uint32> MaterialIndexArray;
-    for (auto temp : RenderData.Sections) {
-        MaterialIndexArray.Add(temp.FirstIndex);
+    // Read back on the game thread, then fix up channels and compress the maps in parallel.
+    FGetModelTextureSnapshot Snapshots[4];
+    bool                     bSnapshots[4] = {};
+    for (int32 MapIndex = 0; MapIndex < 4; MapIndex++) {
+        bSnapshots[MapIndex] = BakedMaps[MapIndex] && SnapshotTexture(BakedMaps[MapIndex], Snapshots[MapIndex]);
     }
 
-    {
-        FIndexArrayView Indices    = RenderData.IndexBuffer.GetArrayView();
-        uint32          NumIndices = Indices.Num();
-
-        check(NumIndices % 3 == 0);
-        int count = 0;
-        for (uint32 i = 0; i < NumIndices / 3; i++) {
-            if (count < MaterialIndexArray.Num() && i == MaterialIndexArray[count] / 3) {
-                FString mtl = StaticMaterials[count].MaterialSlotName.ToString() + TEXT("_") + StaticMaterials[count].MaterialSlotName.ToString();
-                ObjFile->Logf(TEXT("usemtl %s\n"), *FPaths::GetCleanFilename(mtl));  //*FPaths::GetCleanFilename(MaterialName));
-                MtlNames.Add(FPaths::GetCleanFilename(mtl));
-                count++;
+    UTexture2D*              AlphaSource = BakedMaps[4] ? BakedMaps[4] : Opacity;
+    FGetModelTextureSnapshot AlphaSnapshot;
+    const bool               bHasAlpha = bSnapshots[0] && SnapshotTexture(AlphaSource, AlphaSnapshot) && AlphaSnapshot.Pixels.Num() == Snapshots[0].Pixels.Num();
+
+    TArray<uint8> Pngs[4];
+    ParallelFor(4, [&](int32 MapIndex) {
+        if (!bSnapshots[MapIndex]) {
+            return;
+        }
+
+        TArray<FColor>& Pixels = Snapshots[MapIndex].Pixels;
+        for (int32 i = 0; i < Pixels.Num(); i++) {
+            if (MapIndex == 0 && bHasAlpha) {
+                Pixels[i].A = AlphaSnapshot.Pixels[i].R;
+            } else if (MapIndex == 1) {
+                Swap(Pixels[i].R, Pixels[i].B);
+            } else if (MapIndex == 2) {
+                Pixels[i].G = 255 - Pixels[i].G;
             }
+        }
+        EncodeTexture(Snapshots[MapIndex], EGetModelTextureFormat::PNG, Pngs[MapIndex]);
+    });
 
-            // Wavefront indices are 1 based.
-            uint32 a = Indices[3 * i] + 1;
-            uint32 b = Indices[3 * i + 1] + 1;
-            uint32 c = Indices[3 * i + 2] + 1;
+    int32 Textures[4] = {INDEX_NONE, INDEX_NONE, INDEX_NONE, INDEX_NONE};
+    for (int32 MapIndex = 0; MapIndex < 4; MapIndex++) {
+        if (Pngs[MapIndex].Num()) {
+            Textures[MapIndex] = GlbWriter.AddPngTexture(Pngs[MapIndex], Snapshots[MapIndex].Name);
+        }
+    }
 
-            ObjFile->Logf(TEXT("f %d/%d/%d %d/%d/%d %d/%d/%d\r\n"),
-                          a, a, a,
-                          b, b, b,
-                          c, c, c);
+    // The merged mesh has one baked material set, every material slot points at it.
+    TArray<FStaticMaterial> StaticMaterials = MergedMesh->StaticMaterials;
+    for (const FStaticMaterial& StaticMaterial : StaticMaterials) {
+        FString Material = FString::Printf(TEXT("{\"name\":%s,\"pbrMetallicRoughness\":{"), *FGetModelGlbWriter::QuoteString(StaticMaterial.MaterialSlotName.ToString()));
+        Material += Textures[0] != INDEX_NONE ? FString::Printf(TEXT("\"baseColorTexture\":{\"index\":%d}"), Textures[0]) : TEXT("\"baseColorFactor\":[1,1,1,1]");
+        if (Textures[1] != INDEX_NONE) {
+            Material += FString::Printf(TEXT(",\"metallicRoughnessTexture\":{\"index\":%d}"), Textures[1]);
+        }
+        Material += TEXT("}");
+        if (Textures[2] != INDEX_NONE) {
+            Material += FString::Printf(TEXT(",\"normalTexture\":{\"index\":%d}"), Textures[2]);
         }
+        if (Textures[3] != INDEX_NONE) {
+            Material += FString::Printf(TEXT(",\"emissiveTexture\":{\"index\":%d},\"emissiveFactor\":[1,1,1]"), Textures[3]);
+        }
+        if (bHasAlpha) {
+            // Mirrors the default opacity mask clip value.
+            Material += BakedMaps[4] ? TEXT(",\"alphaMode\":\"MASK\",\"alphaCutoff\":0.3333") : TEXT(",\"alphaMode\":\"BLEND\"");
+        }
+        GlbWriter.AddMaterial(Material + TEXT("}"));
     }
 
-    ObjFile->Logf(TEXT("# UnrealEd OBJ exporter\r\n"));
-    delete ObjFile;
+    // Sections become primitives sharing the vertex accessors.
+    for (const FStaticMeshSection& Section : RenderData.Sections) {
+        if (!bHasGeometry || Section.NumTriangles == 0) {
+            continue;
+        }
 
-    return MtlNames;
+        const int32 IndexAccessor = GlbWriter.AddAccessor(IndexView, Section.FirstIndex * sizeof(uint32), FGetModelGlbWriter::UnsignedInt, Section.NumTriangles * 3, TEXT("SCALAR"));
+        FString     Primitive     = FString::Printf(TEXT("{\"attributes\":{\"POSITION\":%d,\"NORMAL\":%d,\"TEXCOORD_0\":%d},\"indices\":%d"), PositionAccessor, NormalAccessor, UVAccessor, IndexAccessor);
+        if (StaticMaterials.IsValidIndex(Section.MaterialIndex)) {
+            Primitive += FString::Printf(TEXT(",\"material\":%d"), Section.MaterialIndex);
+        }
+        GlbWriter.AddPrimitive(Primitive + TEXT("}"));
+    }
+
+    return GlbWriter.SaveToFile(GlbPath, FPaths::GetBaseFilename(GlbPath), 0.01f);
 }
 
-TMap<FString, FString> FGetModelModule::ExportMaterialToBMP(TArray<UObject*>& ObjectsToExport)
+TMap<FString, FString> FGetModelModule::ExportMaterialToBMP(TArray<UObject*>& ObjectsToExport, EGetModelTextureFormat Format, EGetModelTextureFormat NormalFormat, const FString& SavePath)
 {
-    TMap<FString, FString> mtls;
-    TArray<UExporter*>     Exporters;
+    FGetModelMapExport Maps;
+    GatherMaterialMaps(ObjectsToExport, Format, NormalFormat, SavePath.IsEmpty() ? FGetModelExportSettings().GetSavePath() : SavePath, Maps);
+    WriteMaterialMaps(Maps);
 
-    auto TransientPackage = GetTransientPackage();
-    // TODO: Assemble this set once.
-    Exporters.Empty();
-    for (TObjectIterator<UClass> It; It; ++It) {
-        if (It->IsChildOf(UExporter::StaticClass()) && !It->HasAnyClassFlags(CLASS_Abstract)) {
-            UExporter* Exporter = NewObject<UExporter>(TransientPackage, *It);
-            Exporters.Add(Exporter);
-        }
-    }
-    // AssembleListOfExporters(Exporters);
+    return Maps.MtlEntries;
+}
 
-    // NOTE: BMP is 21 instead of 20.
-    UExporter* ExporterUse = Exporters[21];
+void FGetModelModule::GatherMaterialMaps(TArray<UObject*>& ObjectsToExport, EGetModelTextureFormat Format, EGetModelTextureFormat NormalFormat, const FString& SavePath, FGetModelMapExport& OutMaps)
+{
+    TMap<FString, FString>& mtls = OutMaps.MtlEntries;
 
-    FString ProjectPath = FPaths::ConvertRelativePathToFull(FPaths::ProjectContentDir());
+    // Maps in compressed formats are only read back here, WriteMaterialMaps encodes them later.
 
     for (int32 Index = 0; Index < ObjectsToExport.Num(); Index++) {
         FString MapType;
 
-        UObject*   ObjectToExport     = ObjectsToExport[Index];
-        const bool bObjectIsSupported = ExporterUse->SupportsObject(ObjectToExport);
-
-        if (!ObjectToExport || !bObjectIsSupported) {
+        UObject*    ObjectToExport = ObjectsToExport[Index];
+        UTexture2D* Texture        = Cast<UTexture2D>(ObjectToExport);
+        if (!Texture) {
             continue;
         }
 
@@ -463,14 +1412,14 @@ TMap<FString, FString> FGetModelModule::ExportMaterialToBMP(TArray<UObject*>& Ob
 
         FString Filename = TEXT("maps/") + name;
 
-        TArray<FString> ParsedName;
-        ObjectToExport->GetName().ParseIntoArray(ParsedName, TEXT("_"), true);
-        auto NameType = ParsedName.Last();
+        auto                         NameType  = GetBakedMapType(ObjectToExport);
+        const EGetModelTextureFormat MapFormat = NameType == TEXT("Normal") ? NormalFormat : Format;
+        const FString                Extension = FString(TEXT(".")) + GetTextureFormatExtension(MapFormat);
         if (NameType == TEXT("Diffuse")) {
             MapType = TEXT("map_Kd ");
         } else if (NameType == TEXT("MRS")) {
-            mtls.FindOrAdd(TEXT("map_Ks ")) = Filename + TEXT(".bmp");
-            mtls.FindOrAdd(TEXT("map_Pr ")) = Filename + TEXT(".bmp");
+            mtls.FindOrAdd(TEXT("map_Ks ")) = Filename + Extension;
+            mtls.FindOrAdd(TEXT("map_Pr ")) = Filename + Extension;
             MapType                         = TEXT("map_Pm ");
         } else if (NameType == TEXT("Normal")) {
             MapType = TEXT("norm ");
@@ -482,28 +1431,88 @@ TMap<FString, FString> FGetModelModule::ExportMaterialToBMP(TArray<UObject*>& Ob
             MapType = TEXT("map_Ke ");
         }
 
-        Filename += TEXT(".bmp");
-        auto& T = mtls.FindOrAdd(MapType);
-        T       = Filename;
+        Filename += Extension;
 
-        Filename = ProjectPath + TEXT("GetObjandMaterial/") + Filename;
+        if (MapFormat == EGetModelTextureFormat::BMP) {
+            UExporter* ExporterUse = ExporterRegistry->FindExporter(ObjectToExport, TEXT("bmp"));
+            if (!ExporterUse || !ExporterUse->SupportsObject(ObjectToExport)) {
+                continue;
+            }
 
-        UExporter::ExportToFile(ObjectToExport, ExporterUse, *Filename, false, false, false);
-    }
+            if (!UExporter::ExportToFile(ObjectToExport, ExporterUse, *(SavePath + Filename), false, false, false)) {
+                UE_LOG(LogGetModel, Warning, TEXT("Could not write map %s"), *(SavePath + Filename));
+                OutMaps.bGatherFailed = true;
+                continue;
+            }
+
+            auto& T = mtls.FindOrAdd(MapType);
+            T       = Filename;
+            continue;
+        }
 
-    return mtls;
+        FGetModelTextureSnapshot Snapshot;
+        if (SnapshotTexture(Texture, Snapshot)) {
+            auto& T = mtls.FindOrAdd(MapType);
+            T       = Filename;
+
+            OutMaps.Snapshots.Add(MoveTemp(Snapshot));
+            OutMaps.Formats.Add(MapFormat);
+            OutMaps.Filenames.Add(SavePath + Filename);
+        }
+    }
 }
 
 TSharedRef<SDockTab> FGetModelModule::OnSpawnPluginTab(const FSpawnTabArgs& SpawnTabArgs)
 {
     TSharedPtr<SButton> GetMaterialBtn;
     TSharedPtr<SButton> GetObjBtn;
+    TSharedPtr<SButton> GetGlbBtn;
+    TSharedPtr<SButton> GetGmqBtn;
 
     TSharedRef<SDockTab> mainTab = SNew(SDockTab)
                                        .TabRole(ETabRole::NomadTab)
                                        .ShouldAutosize(true)
                                            [SNew(SScrollBox) + SScrollBox::Slot().Padding(10, 5)[SNew(SHorizontalBox) + SHorizontalBox::Slot().AutoWidth().HAlign(HAlign_Left).Padding(4, 4, 10, 4)[SNew(STextBlock).Text(FText::FromString(TEXT("TextureSize(X,Y):")))] + SHorizontalBox::Slot().HAlign(HAlign_Left).Padding(4, 4, 10, 4).AutoWidth()[SAssignNew(TextureSizeX, SSpinBox<int32>).MaxValue(16384).MinValue(1).Value(1024)] + SHorizontalBox::Slot().HAlign(HAlign_Left).Padding(4, 4, 10, 4).AutoWidth()[SAssignNew(TextureSizeY, SSpinBox<int32>).Value(1024).MaxValue(16384).MinValue(1)]]
 
+                                            // Texture size scale per LOD and the size it stops at.
+                                            + SScrollBox::Slot().Padding(10, 5)[SNew(SHorizontalBox) + SHorizontalBox::Slot().AutoWidth().HAlign(HAlign_Left).Padding(4, 4, 10, 4)[SNew(STextBlock).Text(FText::FromString(TEXT("LOD Texture Scale, Min:")))] + SHorizontalBox::Slot().HAlign(HAlign_Left).Padding(4, 4, 10, 4).AutoWidth()[SAssignNew(LODTextureScale, SSpinBox<float>).ToolTipText(FText::FromString(TEXT("Baked map size factor applied once per LOD, 0.5 halves each LOD, 1 bakes every LOD at the full size. Shared baked maps always bake at the full size"))).MaxValue(1.0f).MinValue(0.05f).Value(1.0f)] + SHorizontalBox::Slot().HAlign(HAlign_Left).Padding(4, 4, 10, 4).AutoWidth()[SAssignNew(MinLODTextureSize, SSpinBox<int32>).MaxValue(16384).MinValue(1).Value(64)]]
+
+                                            // Obj float precision, -1 writes the shortest round-trip form.
+                                            + SScrollBox::Slot().Padding(10, 5)[SNew(SHorizontalBox) + SHorizontalBox::Slot().AutoWidth().HAlign(HAlign_Left).Padding(4, 4, 10, 4)[SNew(STextBlock).Text(FText::FromString(TEXT("Obj Float Precision:")))] + SHorizontalBox::Slot().HAlign(HAlign_Left).Padding(4, 4, 10, 4).AutoWidth()[SAssignNew(ObjFloatPrecision, SSpinBox<int32>).ToolTipText(FText::FromString(TEXT("Digits after the decimal point, -1 for shortest round-trip"))).MaxValue(9).MinValue(-1).Value(6)]]
+
+                                            // Checkbox weld vertices and position epsilon.
+                                            + SScrollBox::Slot().Padding(10, 5)[SNew(SHorizontalBox) + SHorizontalBox::Slot().HAlign(HAlign_Center).Padding(4, 4, 10, 4).AutoWidth()[SAssignNew(bWeldVertices, SCheckBox).ToolTipText(FText::FromString(TEXT("Write unique positions, uvs and normals and index them separately"))).IsChecked(ECheckBoxState::Unchecked)] + SHorizontalBox::Slot().AutoWidth().HAlign(HAlign_Left).Padding(4, 4, 10, 4)[SNew(STextBlock).Text(FText::FromString(TEXT("Weld Vertices, Epsilon:")))] + SHorizontalBox::Slot().HAlign(HAlign_Left).Padding(4, 4, 10, 4).AutoWidth()[SAssignNew(WeldEpsilon, SSpinBox<float>).MaxValue(10.0f).MinValue(0.0f).Value(0.01f)]]
+
+                                            // Bits per octahedral normal component of "Export gmq".
+                                            + SScrollBox::Slot().Padding(10, 5)[SNew(SHorizontalBox) + SHorizontalBox::Slot().AutoWidth().HAlign(HAlign_Left).Padding(4, 4, 10, 4)[SNew(STextBlock).Text(FText::FromString(TEXT("Gmq Normal Bits:")))] + SHorizontalBox::Slot().HAlign(HAlign_Left).Padding(4, 4, 10, 4).AutoWidth()[SAssignNew(QuantizedNormalBits, SSpinBox<int32>).ToolTipText(FText::FromString(TEXT("8 or 16 bits per octahedral normal component"))).Delta(8).MaxValue(16).MinValue(8).Value(8)]]
+
+                                            // bOptimizeVertexCache, bOptimizeOverdraw.
+                                            + SScrollBox::Slot().Padding(10, 5)[SNew(SHorizontalBox) + SHorizontalBox::Slot().HAlign(HAlign_Center).Padding(4, 4, 10, 4).AutoWidth()[SAssignNew(bOptimizeVertexCache, SCheckBox).ToolTipText(FText::FromString(TEXT("Reorder triangles within each material for the GPU vertex cache, then vertices in first-use order"))).IsChecked(ECheckBoxState::Unchecked)] + SHorizontalBox::Slot().AutoWidth().HAlign(HAlign_Left).Padding(4, 4, 10, 4)[SNew(STextBlock).Text(FText::FromString(TEXT("Optimize Vertex Cache")))] + SHorizontalBox::Slot().HAlign(HAlign_Center).Padding(4, 4, 10, 4).AutoWidth()[SAssignNew(bOptimizeOverdraw, SCheckBox).ToolTipText(FText::FromString(TEXT("Also draw outward facing triangle clusters first to cut overdraw"))).IsChecked(ECheckBoxState::Unchecked)] + SHorizontalBox::Slot().AutoWidth().HAlign(HAlign_Left).Padding(4, 4, 10, 4)[SNew(STextBlock).Text(FText::FromString(TEXT("Overdraw")))]]
+
+                                            // Checkbox skip unchanged.
+                                            + SScrollBox::Slot().Padding(10, 5)[SNew(SHorizontalBox) + SHorizontalBox::Slot().HAlign(HAlign_Center).Padding(4, 4, 10, 4).AutoWidth()[SAssignNew(bSkipUnchanged, SCheckBox).ToolTipText(FText::FromString(TEXT("Skip components whose mesh, materials, transform and settings did not change since the last export"))).IsChecked(ECheckBoxState::Checked)] + SHorizontalBox::Slot().AutoWidth().HAlign(HAlign_Left).Padding(4, 4, 10, 4)[SNew(STextBlock).Text(FText::FromString(TEXT("Skip Unchanged")))]]
+
+                                            // Checkbox batch merge, with the batch size and the distance batched components must be within.
+                                            + SScrollBox::Slot().Padding(10, 5)[SNew(SHorizontalBox) + SHorizontalBox::Slot().HAlign(HAlign_Center).Padding(4, 4, 10, 4).AutoWidth()[SAssignNew(bBatchMerge, SCheckBox).ToolTipText(FText::FromString(TEXT("Merge nearby components together into one mesh with an atlased material"))).IsChecked(ECheckBoxState::Unchecked)] + SHorizontalBox::Slot().AutoWidth().HAlign(HAlign_Left).Padding(4, 4, 10, 4)[SNew(STextBlock).Text(FText::FromString(TEXT("Batch Merge, Group Size:")))] + SHorizontalBox::Slot().HAlign(HAlign_Left).Padding(4, 4, 10, 4).AutoWidth()[SAssignNew(BatchSize, SSpinBox<int32>).MaxValue(1024).MinValue(2).Value(16)] + SHorizontalBox::Slot().AutoWidth().HAlign(HAlign_Left).Padding(4, 4, 10, 4)[SNew(STextBlock).Text(FText::FromString(TEXT("Max Distance:")))] + SHorizontalBox::Slot().HAlign(HAlign_Left).Padding(4, 4, 10, 4).AutoWidth()[SAssignNew(BatchDistance, SSpinBox<float>).ToolTipText(FText::FromString(TEXT("0 for any distance"))).MaxValue(1000000.0f).MinValue(0.0f).Value(0.0f)]]
+
+                                            // Checkbox fast geometry.
+                                            + SScrollBox::Slot().Padding(10, 5)[SNew(SHorizontalBox) + SHorizontalBox::Slot().HAlign(HAlign_Center).Padding(4, 4, 10, 4).AutoWidth()[SAssignNew(bFastGeometry, SCheckBox).ToolTipText(FText::FromString(TEXT("Export each component's own LODs without merging or baking maps, the mtl names the original materials"))).IsChecked(ECheckBoxState::Unchecked)] + SHorizontalBox::Slot().AutoWidth().HAlign(HAlign_Left).Padding(4, 4, 10, 4)[SNew(STextBlock).Text(FText::FromString(TEXT("Geometry Only (No Bake)")))]]
+
+                                            // Checkbox instance tables, optionally expanded into the mesh file.
+                                            + SScrollBox::Slot().Padding(10, 5)[SNew(SHorizontalBox) + SHorizontalBox::Slot().HAlign(HAlign_Center).Padding(4, 4, 10, 4).AutoWidth()[SAssignNew(bInstanceTables, SCheckBox).ToolTipText(FText::FromString(TEXT("Export instanced and foliage components as their mesh once plus a csv of instance transforms"))).IsChecked(ECheckBoxState::Unchecked)] + SHorizontalBox::Slot().AutoWidth().HAlign(HAlign_Left).Padding(4, 4, 10, 4)[SNew(STextBlock).Text(FText::FromString(TEXT("Instance Tables")))] + SHorizontalBox::Slot().HAlign(HAlign_Center).Padding(4, 4, 10, 4).AutoWidth()[SAssignNew(bExpandInstances, SCheckBox).ToolTipText(FText::FromString(TEXT("Write every instance's copy into the mesh file instead of the csv"))).IsChecked(ECheckBoxState::Unchecked)] + SHorizontalBox::Slot().AutoWidth().HAlign(HAlign_Left).Padding(4, 4, 10, 4)[SNew(STextBlock).Text(FText::FromString(TEXT("Expand")))]]
+
+                                            // Checkbox landscapes, with the LOD they are sampled at and their weightmaps.
+                                            + SScrollBox::Slot().Padding(10, 5)[SNew(SHorizontalBox) + SHorizontalBox::Slot().HAlign(HAlign_Center).Padding(4, 4, 10, 4).AutoWidth()[SAssignNew(bExportLandscapes, SCheckBox).ToolTipText(FText::FromString(TEXT("Stream selected landscapes into one obj each, component by component"))).IsChecked(ECheckBoxState::Unchecked)] + SHorizontalBox::Slot().AutoWidth().HAlign(HAlign_Left).Padding(4, 4, 10, 4)[SNew(STextBlock).Text(FText::FromString(TEXT("Landscapes, LOD:")))] + SHorizontalBox::Slot().HAlign(HAlign_Left).Padding(4, 4, 10, 4).AutoWidth()[SAssignNew(LandscapeLOD, SSpinBox<int32>).MaxValue(7).MinValue(0).Value(0)] + SHorizontalBox::Slot().HAlign(HAlign_Center).Padding(4, 4, 10, 4).AutoWidth()[SAssignNew(bLandscapeWeightmaps, SCheckBox).ToolTipText(FText::FromString(TEXT("Also write each paint layer's weights, one tile per landscape component"))).IsChecked(ECheckBoxState::Unchecked)] + SHorizontalBox::Slot().AutoWidth().HAlign(HAlign_Left).Padding(4, 4, 10, 4)[SNew(STextBlock).Text(FText::FromString(TEXT("Weightmaps")))]]
+
+                                            // Checkbox transient merge.
+                                            + SScrollBox::Slot().Padding(10, 5)[SNew(SHorizontalBox) + SHorizontalBox::Slot().HAlign(HAlign_Center).Padding(4, 4, 10, 4).AutoWidth()[SAssignNew(bTransientMerge, SCheckBox).ToolTipText(FText::FromString(TEXT("Export from merged meshes and maps kept in memory only, without creating assets in the project"))).IsChecked(ECheckBoxState::Unchecked)] + SHorizontalBox::Slot().AutoWidth().HAlign(HAlign_Left).Padding(4, 4, 10, 4)[SNew(STextBlock).Text(FText::FromString(TEXT("Transient Merge")))]]
+
+                                            // Tile size, 0 exports the whole selection at once.
+                                            + SScrollBox::Slot().Padding(10, 5)[SNew(SHorizontalBox) + SHorizontalBox::Slot().AutoWidth().HAlign(HAlign_Left).Padding(4, 4, 10, 4)[SNew(STextBlock).Text(FText::FromString(TEXT("Tile Size:")))] + SHorizontalBox::Slot().HAlign(HAlign_Left).Padding(4, 4, 10, 4).AutoWidth()[SAssignNew(TileSize, SSpinBox<float>).ToolTipText(FText::FromString(TEXT("Export the selection in squares of this size one after another, each into its own folder. Merged meshes and maps are kept in memory only, like Transient Merge, and discarded after each tile. 0 exports everything at once"))).MaxValue(10000000.0f).MinValue(0.0f).Value(0.0f)]]
+
+                                            // Checkbox share baked maps across LODs and the LOD they are baked from.
+                                            + SScrollBox::Slot().Padding(10, 5)[SNew(SHorizontalBox) + SHorizontalBox::Slot().HAlign(HAlign_Center).Padding(4, 4, 10, 4).AutoWidth()[SAssignNew(bShareBakedMaps, SCheckBox).ToolTipText(FText::FromString(TEXT("Bake the maps of one LOD only, the other LODs are merged as geometry and reference them. A coarse triangle spanning several charts of the atlas shows only one of them"))).IsChecked(ECheckBoxState::Unchecked)] + SHorizontalBox::Slot().AutoWidth().HAlign(HAlign_Left).Padding(4, 4, 10, 4)[SNew(STextBlock).Text(FText::FromString(TEXT("Share Baked Maps, Bake LOD:")))] + SHorizontalBox::Slot().HAlign(HAlign_Left).Padding(4, 4, 10, 4).AutoWidth()[SAssignNew(BakeLOD, SSpinBox<int32>).MaxValue(7).MinValue(0).Value(0)]]
+
                                             // bInstancingMultiActors.
                                             + SScrollBox::Slot().Padding(10, 5)[SNew(SHorizontalBox) + SHorizontalBox::Slot().HAlign(HAlign_Center).Padding(4, 4, 10, 4).AutoWidth()[SAssignNew(bInstancingMultiActors, SCheckBox).ToolTipText(FText::FromString(TEXT("Instancing Multi Actors"))).IsChecked(ECheckBoxState::Checked)] + SHorizontalBox::Slot().AutoWidth().HAlign(HAlign_Left).Padding(4, 4, 10, 4)[SNew(STextBlock).Text(FText::FromString(TEXT("Instancing Multi Actors")))]]
 
@@ -522,8 +1531,11 @@ TSharedRef<SDockTab> FGetModelModule::OnSpawnPluginTab(const FSpawnTabArgs& Spaw
                                             // Checkbox e.
                                             + SScrollBox::Slot().Padding(10, 5)[SNew(SHorizontalBox) + SHorizontalBox::Slot().HAlign(HAlign_Center).Padding(4, 4, 10, 4).AutoWidth()[SAssignNew(bEmissiveMap, SCheckBox).ToolTipText(FText::FromString(TEXT("Export Emissive Map"))).IsChecked(ECheckBoxState::Unchecked)] + SHorizontalBox::Slot().AutoWidth().HAlign(HAlign_Left).Padding(4, 4, 10, 4)[SNew(STextBlock).Text(FText::FromString(TEXT("Export Emissive Map")))]]
 
+                                            // Texture formats.
+                                            + SScrollBox::Slot().Padding(10, 5)[SNew(SHorizontalBox) + SHorizontalBox::Slot().AutoWidth().HAlign(HAlign_Left).Padding(4, 4, 10, 4)[SNew(STextBlock).Text(FText::FromString(TEXT("Texture Format:")))] + SHorizontalBox::Slot().HAlign(HAlign_Left).Padding(4, 4, 10, 4).AutoWidth()[MakeTextureFormatCombo(TextureFormat, EGetModelTextureFormat::BMP)] + SHorizontalBox::Slot().AutoWidth().HAlign(HAlign_Left).Padding(4, 4, 10, 4)[SNew(STextBlock).Text(FText::FromString(TEXT("Normal Map Format:")))] + SHorizontalBox::Slot().HAlign(HAlign_Left).Padding(4, 4, 10, 4).AutoWidth()[MakeTextureFormatCombo(NormalMapFormat, EGetModelTextureFormat::BMP)]]
+
                                             // Button.
-                                            + SScrollBox::Slot().Padding(10, 5)[SNew(SHorizontalBox) + SHorizontalBox::Slot().HAlign(HAlign_Center).Padding(4, 4, 10, 4).AutoWidth()[SAssignNew(GetMaterialBtn, SButton).Text(LOCTEXT("GetMaterial", "Get material")).OnClicked_Raw(this, &FGetModelModule::GenerateMergeObj)] + SHorizontalBox::Slot().HAlign(HAlign_Center).Padding(4, 4, 10, 4).AutoWidth()[SAssignNew(GetObjBtn, SButton).Text(LOCTEXT("GetObjAndMtl", "Export obj And mtl")).OnClicked_Raw(this, &FGetModelModule::ExportMergeObj)]]];
+                                            + SScrollBox::Slot().Padding(10, 5)[SNew(SHorizontalBox) + SHorizontalBox::Slot().HAlign(HAlign_Center).Padding(4, 4, 10, 4).AutoWidth()[SAssignNew(GetMaterialBtn, SButton).Text(LOCTEXT("GetMaterial", "Get material")).OnClicked_Raw(this, &FGetModelModule::GenerateMergeObj)] + SHorizontalBox::Slot().HAlign(HAlign_Center).Padding(4, 4, 10, 4).AutoWidth()[SAssignNew(GetObjBtn, SButton).Text(LOCTEXT("GetObjAndMtl", "Export obj And mtl")).OnClicked_Raw(this, &FGetModelModule::ExportMergeObj)] + SHorizontalBox::Slot().HAlign(HAlign_Center).Padding(4, 4, 10, 4).AutoWidth()[SAssignNew(GetGlbBtn, SButton).Text(LOCTEXT("GetGlb", "Export glb")).OnClicked_Raw(this, &FGetModelModule::ExportMergeGlb)] + SHorizontalBox::Slot().HAlign(HAlign_Center).Padding(4, 4, 10, 4).AutoWidth()[SAssignNew(GetGmqBtn, SButton).Text(LOCTEXT("GetGmq", "Export gmq")).ToolTipText(FText::FromString(TEXT("Quantized, compressed geometry with an mtl and maps like obj"))).OnClicked_Raw(this, &FGetModelModule::ExportMergeGmq)]]];
     return mainTab;
 }
 
@@ -0,0 +1,92 @@
+// Copyright 1998-2019 Epic Games, Inc. All Rights Reserved.
+
+#include "GetModelAsyncFileWriter.h"
+
+#include "Async/Async.h"
+#include "GenericPlatform/GenericPlatformFile.h"
+#include "HAL/PlatformFilemanager.h"
+#include "Misc/Paths.h"
+
+FGetModelAsyncFileWriter::FGetModelAsyncFileWriter(const FString& InFilename, int32 InNumBuffers)
+    : Filename(InFilename)
+    , NumBuffers(FMath::Max(1, InNumBuffers))
+{
+    IPlatformFile& PlatformFile = FPlatformFileManager::Get().GetPlatformFile();
+    PlatformFile.CreateDirectoryTree(*FPaths::GetPath(Filename));
+    Handle.Reset(PlatformFile.OpenWrite(*Filename));
+    bError = !Handle.IsValid();
+}
+
+FGetModelAsyncFileWriter::~FGetModelAsyncFileWriter()
+{
+    Close();
+}
+
+void FGetModelAsyncFileWriter::Preallocate(int64 Size)
+{
+    if (!Handle.IsValid() || Size <= FMath::Max(WriteOffset, PreallocatedSize)) {
+        return;
+    }
+
+    // Writing the last byte makes the file system reserve everything before it.
+    FScopeLock Lock(&HandleLock);
+    const uint8 Zero = 0;
+    if (Handle->Seek(Size - 1) && Handle->Write(&Zero, 1)) {
+        PreallocatedSize = Size;
+    }
+}
+
+void FGetModelAsyncFileWriter::Write(TArray<ANSICHAR>& Block)
+{
+    if (!Handle.IsValid() || !Block.Num()) {
+        Block.Reset();
+        return;
+    }
+
+    if (InFlight.Num() >= NumBuffers) {
+        InFlight[0].Wait();
+        InFlight.RemoveAt(0);
+    }
+
+    TArray<ANSICHAR> Data;
+    {
+        FScopeLock Lock(&FreeBuffersLock);
+        if (FreeBuffers.Num()) {
+            Data = FreeBuffers.Pop(false);
+        }
+    }
+    Swap(Data, Block);
+
+    const int64 Offset = WriteOffset;
+    WriteOffset += Data.Num();
+    InFlight.Add(Async(EAsyncExecution::TaskGraph, [this, Offset, Data = MoveTemp(Data)]() mutable {
+        {
+            FScopeLock Lock(&HandleLock);
+            if (!Handle->Seek(Offset) || !Handle->Write((const uint8*)Data.GetData(), Data.Num())) {
+                bError = true;
+            }
+        }
+
+        // Keep the allocation for the next block.
+        Data.Reset();
+        FScopeLock Lock(&FreeBuffersLock);
+        FreeBuffers.Add(MoveTemp(Data));
+    }));
+}
+
+bool FGetModelAsyncFileWriter::Close()
+{
+    for (TFuture<void>& Block : InFlight) {
+        Block.Wait();
+    }
+    InFlight.Reset();
+    FreeBuffers.Empty();
+
+    if (Handle.IsValid()) {
+        if (PreallocatedSize > WriteOffset && !Handle->Truncate(WriteOffset)) {
+            bError = true;
+        }
+        Handle.Reset();
+    }
+    return !bError;
+}
@@ -0,0 +1,52 @@
+// Copyright 1998-2019 Epic Games, Inc. All Rights Reserved.
+
+#pragma once
+
+#include "Async/Future.h"
+#include "CoreMinimal.h"
+#include "HAL/CriticalSection.h"
+#include "HAL/ThreadSafeBool.h"
+
+class IFileHandle;
+
+/**
+ * Sequential file output that overlaps formatting with disk writes. The caller hands over a filled block and gets a
+ * recycled empty one back while the block is written on a task graph worker; at most NumBuffers blocks are in flight
+ * before Write waits on the oldest. Blocks carry their own file offset, so they may land in any order.
+ *
+ * Export jobs write through this class from GThreadPool, so blocks must never go to the pool: with every pool thread
+ * waiting on a block queued behind them, nothing would run it. Do not use it from inside a task graph task either.
+ */
+class FGetModelAsyncFileWriter
+{
+public:
+    static const int32 DefaultNumBuffers = 3;
+
+    explicit FGetModelAsyncFileWriter(const FString& InFilename, int32 InNumBuffers = DefaultNumBuffers);
+    ~FGetModelAsyncFileWriter();
+
+    bool IsOpen() const { return Handle.IsValid(); }
+
+    /** Grows the file to its final size up front, when known; anything not written by Close is cut off again. */
+    void Preallocate(int64 Size);
+
+    /** Queues Block for writing and swaps in an empty buffer, reusing the allocation of a finished block if possible. */
+    void Write(TArray<ANSICHAR>& Block);
+
+    /** Waits for every block, trims a preallocation and closes the file. Returns false if anything failed. */
+    bool Close();
+
+    bool IsError() const { return bError; }
+
+private:
+    FString                  Filename;
+    TUniquePtr<IFileHandle>  Handle;
+    FCriticalSection         HandleLock;
+    TArray<TFuture<void>>    InFlight;
+    TArray<TArray<ANSICHAR>> FreeBuffers;
+    FCriticalSection         FreeBuffersLock;
+    int32                    NumBuffers;
+    int64                    WriteOffset      = 0;
+    int64                    PreallocatedSize = 0;
+    FThreadSafeBool          bError;
+};
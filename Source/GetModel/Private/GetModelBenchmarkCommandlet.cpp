@@ -0,0 +1,332 @@
+// Copyright 1998-2019 Epic Games, Inc. All Rights Reserved.
+
+#include "GetModelBenchmarkCommandlet.h"
+
+#include "Components/StaticMeshComponent.h"
+#include "Engine/StaticMesh.h"
+#include "Engine/Texture2D.h"
+#include "GetModel.h"
+#include "GetModelExportSettings.h"
+#include "GetModelTextureEncoder.h"
+#include "HAL/FileManager.h"
+#include "HAL/PlatformMemory.h"
+#include "HAL/PlatformProcess.h"
+#include "HAL/Runnable.h"
+#include "HAL/RunnableThread.h"
+#include "HAL/ThreadSafeBool.h"
+#include "Materials/Material.h"
+#include "Misc/FileHelper.h"
+#include "Misc/Parse.h"
+#include "Misc/Paths.h"
+#include "Modules/ModuleManager.h"
+#include "RawMesh.h"
+#include "UObject/Package.h"
+
+namespace
+{
+// Bytes is what the rate is taken over: the obj written, or the raw BGRA8 pixels for maps so every format compares.
+// PhysicalGrowth is the most the case's used physical memory rose above where it started while it was timed.
+struct FBenchmarkResult
+{
+    FString Name;
+    int64   Items          = 0;
+    int64   Bytes          = 0;
+    int64   FileBytes      = 0;
+    double  Seconds        = 0.0;
+    uint64  PhysicalGrowth = 0;
+
+    void AddPeakPhysical(uint64 PeakPhysical, uint64 StartPhysical)
+    {
+        PhysicalGrowth = FMath::Max(PhysicalGrowth, PeakPhysical > StartPhysical ? PeakPhysical - StartPhysical : 0);
+    }
+
+    double ItemsPerSecond() const
+    {
+        return Seconds > 0.0 ? Items / Seconds : 0.0;
+    }
+
+    double MegabytesPerSecond() const
+    {
+        return Seconds > 0.0 ? Bytes / (1024.0 * 1024.0) / Seconds : 0.0;
+    }
+};
+
+// Polls used physical memory on its own thread from construction to Stop, so what a timed call allocates and frees
+// again before returning still counts. A millisecond apart keeps it off the profile of the call it watches.
+class FPhysicalPeakSampler : public FRunnable
+{
+public:
+    FPhysicalPeakSampler()
+        : PeakPhysical(FPlatformMemory::GetStats().UsedPhysical)
+    {
+        Thread = FRunnableThread::Create(this, TEXT("GetModelBenchmarkMemory"), 0, TPri_AboveNormal);
+    }
+
+    virtual ~FPhysicalPeakSampler()
+    {
+        Stop();
+        delete Thread;
+    }
+
+    virtual uint32 Run() override
+    {
+        while (!bStopping) {
+            Sample();
+            FPlatformProcess::Sleep(0.001f);
+        }
+        return 0;
+    }
+
+    virtual void Stop() override
+    {
+        bStopping = true;
+        if (Thread) {
+            Thread->WaitForCompletion();
+        }
+    }
+
+    /** Stops polling and returns the most used physical memory seen. */
+    uint64 StopAndGetPeak()
+    {
+        Stop();
+        Sample();
+        return PeakPhysical;
+    }
+
+private:
+    void Sample()
+    {
+        PeakPhysical = FMath::Max<uint64>(PeakPhysical, FPlatformMemory::GetStats().UsedPhysical);
+    }
+
+    FRunnableThread* Thread = nullptr;
+    FThreadSafeBool  bStopping;
+    uint64           PeakPhysical;
+};
+
+// A gently displaced grid, so positions and normals are not all the same value, cut into sections by rows.
+UStaticMesh* BuildSyntheticMesh(int32 NumVertices, int32 NumSections)
+{
+    const int32 Side = FMath::Max(NumSections + 1, FMath::CeilToInt(FMath::Sqrt((float)NumVertices)));
+
+    FRawMesh RawMesh;
+    RawMesh.VertexPositions.Reserve(Side * Side);
+    for (int32 Y = 0; Y < Side; Y++) {
+        for (int32 X = 0; X < Side; X++) {
+            RawMesh.VertexPositions.Add(FVector(X * 10.0f, Y * 10.0f, FMath::Sin(X * 0.1f) * FMath::Cos(Y * 0.1f) * 50.0f));
+        }
+    }
+
+    const int32 NumWedges = (Side - 1) * (Side - 1) * 6;
+    RawMesh.WedgeIndices.Reserve(NumWedges);
+    RawMesh.WedgeTexCoords[0].Reserve(NumWedges);
+    RawMesh.WedgeTangentZ.Reserve(NumWedges);
+    RawMesh.FaceMaterialIndices.Reserve(NumWedges / 3);
+    RawMesh.FaceSmoothingMasks.Reserve(NumWedges / 3);
+    for (int32 Y = 0; Y < Side - 1; Y++) {
+        const int32 Section = Y * NumSections / (Side - 1);
+        for (int32 X = 0; X < Side - 1; X++) {
+            const int32 Corners[6] = {Y * Side + X, (Y + 1) * Side + X, Y * Side + X + 1, Y * Side + X + 1, (Y + 1) * Side + X, (Y + 1) * Side + X + 1};
+            for (int32 Corner : Corners) {
+                const FVector& Position = RawMesh.VertexPositions[Corner];
+                RawMesh.WedgeIndices.Add(Corner);
+                RawMesh.WedgeTexCoords[0].Add(FVector2D((float)(Corner % Side) / (Side - 1), (float)(Corner / Side) / (Side - 1)));
+                RawMesh.WedgeTangentZ.Add(FVector(-FMath::Cos(Position.X * 0.01f), -FMath::Sin(Position.Y * 0.01f), 1.0f).GetSafeNormal());
+            }
+            RawMesh.FaceMaterialIndices.Add(Section);
+            RawMesh.FaceMaterialIndices.Add(Section);
+            RawMesh.FaceSmoothingMasks.Add(1);
+            RawMesh.FaceSmoothingMasks.Add(1);
+        }
+    }
+
+    UStaticMesh* Mesh = NewObject<UStaticMesh>(GetTransientPackage(), *FString::Printf(TEXT("SM_Benchmark_%d_%d"), NumVertices, NumSections), RF_Transient);
+
+    FStaticMeshSourceModel& SourceModel                   = Mesh->AddSourceModel();
+    SourceModel.BuildSettings.bRecomputeNormals           = false;
+    SourceModel.BuildSettings.bRecomputeTangents          = true;
+    SourceModel.BuildSettings.bUseMikkTSpace              = false;
+    SourceModel.BuildSettings.bGenerateLightmapUVs        = false;
+    SourceModel.BuildSettings.bBuildAdjacencyBuffer       = false;
+    SourceModel.BuildSettings.bBuildReversedIndexBuffer   = false;
+    SourceModel.BuildSettings.bRemoveDegenerates          = false;
+    SourceModel.SaveRawMesh(RawMesh);
+
+    for (int32 Section = 0; Section < NumSections; Section++) {
+        Mesh->StaticMaterials.Add(FStaticMaterial(UMaterial::GetDefaultMaterial(MD_Surface), *FString::Printf(TEXT("Section%d"), Section)));
+    }
+    Mesh->Build(true);
+    return Mesh;
+}
+
+// Baked maps are recognised by their name suffix. The pattern keeps compressed formats from collapsing to nothing.
+UTexture2D* BuildSyntheticMap(const FString& Name, int32 Size)
+{
+    UTexture2D* Texture = NewObject<UTexture2D>(GetTransientPackage(), *Name, RF_Transient);
+    Texture->Source.Init(Size, Size, 1, 1, TSF_BGRA8);
+
+    FColor* Pixels = (FColor*)Texture->Source.LockMip(0);
+    for (int32 Y = 0; Y < Size; Y++) {
+        for (int32 X = 0; X < Size; X++) {
+            Pixels[Y * Size + X] = FColor(X & 0xFF, Y & 0xFF, (X ^ Y) & 0xFF, 0xFF);
+        }
+    }
+    Texture->Source.UnlockMip(0);
+    return Texture;
+}
+
+TMap<FString, double> LoadBaseline(const FString& Filename)
+{
+    TMap<FString, double> Baseline;
+    TArray<FString>       Lines;
+    FFileHelper::LoadFileToStringArray(Lines, *Filename);
+    for (int32 LineIndex = 1; LineIndex < Lines.Num(); LineIndex++) {
+        TArray<FString> Fields;
+        Lines[LineIndex].ParseIntoArray(Fields, TEXT(","), false);
+        if (Fields.Num() >= 4) {
+            Baseline.Add(Fields[0], FCString::Atod(*Fields[3]));
+        }
+    }
+    return Baseline;
+}
+
+bool SaveResults(const FString& Filename, const TArray<FBenchmarkResult>& Results)
+{
+    TArray<FString> Lines;
+    Lines.Add(TEXT("Case,Seconds,ItemsPerSecond,MBPerSecond,Bytes,FileBytes,PhysicalGrowthMB"));
+    for (const FBenchmarkResult& Result : Results) {
+        Lines.Add(FString::Printf(TEXT("%s,%.4f,%.0f,%.2f,%lld,%lld,%llu"), *Result.Name, Result.Seconds, Result.ItemsPerSecond(), Result.MegabytesPerSecond(), Result.Bytes, Result.FileBytes, Result.PhysicalGrowth / (1024 * 1024)));
+    }
+    return FFileHelper::SaveStringArrayToFile(Lines, *Filename);
+}
+}  // namespace
+
+void FGetModelBenchmarkOptions::ParseCommandLine(const TCHAR* Params)
+{
+    FParse::Value(Params, TEXT("-Cases="), Cases);
+    FParse::Value(Params, TEXT("-Iterations="), Iterations);
+    FParse::Value(Params, TEXT("-Report="), ReportPath);
+    FParse::Value(Params, TEXT("-Baseline="), BaselinePath);
+    FParse::Value(Params, TEXT("-Threshold="), Threshold);
+    bSaveBaseline = FParse::Param(Params, TEXT("SaveBaseline"));
+
+    Iterations = FMath::Max(Iterations, 1);
+}
+
+UGetModelBenchmarkCommandlet::UGetModelBenchmarkCommandlet()
+{
+    IsClient        = false;
+    IsEditor        = true;
+    IsServer        = false;
+    LogToConsole    = true;
+    HelpDescription = TEXT("Times the obj and map exporters on synthetic meshes and textures, optionally against a baseline.");
+    HelpUsage       = TEXT("-run=GetModelBenchmark [-Cases=VerticesxSections+...] [-TextureSize=N] [-TextureFormat=fmt] [-Iterations=N] [-Baseline=File [-Threshold=0.2] [-SaveBaseline]] [-Report=File]");
+}
+
+int32 UGetModelBenchmarkCommandlet::Main(const FString& Params)
+{
+    FGetModelExportSettings Settings;
+    Settings.ParseCommandLine(*Params);
+
+    const FString             OutputDir = FPaths::ConvertRelativePathToFull(FPaths::ProjectSavedDir()) + TEXT("GetModelBenchmark/");
+    FGetModelBenchmarkOptions Options;
+    Options.ReportPath = OutputDir + TEXT("Benchmark.csv");
+    Options.ParseCommandLine(*Params);
+
+    FGetModelModule&         GetModelModule = FModuleManager::LoadModuleChecked<FGetModelModule>("GetModel");
+    TArray<FBenchmarkResult> Results;
+    UStaticMeshComponent*    Component = NewObject<UStaticMeshComponent>(GetTransientPackage(), NAME_None, RF_Transient);
+
+    TArray<FString> Cases;
+    Options.Cases.ParseIntoArray(Cases, TEXT("+"), true);
+    for (const FString& Case : Cases) {
+        FString VerticesText;
+        FString SectionsText;
+        if (!Case.Split(TEXT("x"), &VerticesText, &SectionsText)) {
+            UE_LOG(LogGetModel, Error, TEXT("Bad case %s, expected <vertices>x<sections>"), *Case);
+            return 1;
+        }
+
+        const uint64 StartPhysical = FPlatformMemory::GetStats().UsedPhysical;
+        UStaticMesh* Mesh = BuildSyntheticMesh(FCString::Atoi(*VerticesText), FMath::Clamp(FCString::Atoi(*SectionsText), 1, 64));
+        Component->SetStaticMesh(Mesh);
+
+        FBenchmarkResult Result;
+        Result.Name    = TEXT("Obj_") + Case;
+        Result.Items   = Mesh->RenderData->LODResources[0].GetNumVertices();
+        Result.Seconds = MAX_dbl;
+
+        FString ObjPath = OutputDir + Mesh->GetName() + TEXT(".obj");
+        for (int32 Iteration = 0; Iteration < Options.Iterations; Iteration++) {
+            FPhysicalPeakSampler Sampler;
+            const double         StartSeconds = FPlatformTime::Seconds();
+            GetModelModule.ExportObj(Mesh, ObjPath, 0, Component, Settings.FloatPrecision);
+            Result.Seconds = FMath::Min(Result.Seconds, FPlatformTime::Seconds() - StartSeconds);
+            Result.AddPeakPhysical(Sampler.StopAndGetPeak(), StartPhysical);
+        }
+        Result.Bytes     = IFileManager::Get().FileSize(*ObjPath);
+        Result.FileBytes = Result.Bytes;
+        Results.Add(Result);
+
+        Component->SetStaticMesh(nullptr);
+        Mesh->MarkPendingKill();
+        CollectGarbage(GARBAGE_COLLECTION_KEEPFLAGS);
+    }
+
+    // One full set of baked maps, in the format and size asked for.
+    {
+        const uint64     StartPhysical = FPlatformMemory::GetStats().UsedPhysical;
+        TArray<UObject*> Maps;
+        for (const TCHAR* MapType : {TEXT("Diffuse"), TEXT("MRS"), TEXT("Normal"), TEXT("Opacity"), TEXT("Emissive")}) {
+            Maps.Add(BuildSyntheticMap(FString(TEXT("T_Benchmark_")) + MapType, Settings.TextureSize.X));
+        }
+
+        FBenchmarkResult Result;
+        Result.Name    = FString::Printf(TEXT("Maps_%s_%d"), GetTextureFormatExtension(Settings.TextureFormat), Settings.TextureSize.X);
+        Result.Items   = (int64)Maps.Num() * Settings.TextureSize.X * Settings.TextureSize.X;
+        Result.Bytes   = Result.Items * sizeof(FColor);
+        Result.Seconds = MAX_dbl;
+
+        TMap<FString, FString> MtlEntries;
+        for (int32 Iteration = 0; Iteration < Options.Iterations; Iteration++) {
+            FPhysicalPeakSampler Sampler;
+            const double         StartSeconds = FPlatformTime::Seconds();
+            MtlEntries                        = GetModelModule.ExportMaterialToBMP(Maps, Settings.TextureFormat, Settings.TextureFormat, OutputDir);
+            Result.Seconds                    = FMath::Min(Result.Seconds, FPlatformTime::Seconds() - StartSeconds);
+            Result.AddPeakPhysical(Sampler.StopAndGetPeak(), StartPhysical);
+        }
+        TSet<FString> Written;
+        for (const auto& MtlEntry : MtlEntries) {
+            Written.Add(MtlEntry.Value);
+        }
+        for (const FString& File : Written) {
+            Result.FileBytes += FMath::Max<int64>(IFileManager::Get().FileSize(*(OutputDir + File)), 0);
+        }
+        Results.Add(Result);
+    }
+
+    for (const FBenchmarkResult& Result : Results) {
+        UE_LOG(LogGetModel, Display, TEXT("%-24s %9.3f s %14.0f items/s %9.2f MB/s memory +%llu MB"), *Result.Name, Result.Seconds, Result.ItemsPerSecond(), Result.MegabytesPerSecond(), Result.PhysicalGrowth / (1024 * 1024));
+    }
+    SaveResults(Options.ReportPath, Results);
+
+    if (Options.BaselinePath.IsEmpty()) {
+        return 0;
+    }
+    if (Options.bSaveBaseline) {
+        SaveResults(Options.BaselinePath, Results);
+        UE_LOG(LogGetModel, Display, TEXT("Baseline written to %s"), *Options.BaselinePath);
+        return 0;
+    }
+
+    const TMap<FString, double> Baseline = LoadBaseline(Options.BaselinePath);
+    int32                       Result   = 0;
+    for (const FBenchmarkResult& Current : Results) {
+        const double* BaselineMBPerSecond = Baseline.Find(Current.Name);
+        if (BaselineMBPerSecond && Current.MegabytesPerSecond() < *BaselineMBPerSecond * (1.0 - Options.Threshold)) {
+            UE_LOG(LogGetModel, Error, TEXT("%s regressed: %.2f MB/s, baseline %.2f MB/s"), *Current.Name, Current.MegabytesPerSecond(), *BaselineMBPerSecond);
+            Result = 1;
+        }
+    }
+    return Result;
+}
@@ -0,0 +1,46 @@
+// Copyright 1998-2019 Epic Games, Inc. All Rights Reserved.
+
+#pragma once
+
+#include "Commandlets/Commandlet.h"
+#include "CoreMinimal.h"
+
+#include "GetModelBenchmarkCommandlet.generated.h"
+
+/**
+ * Times ExportObj and ExportMaterialToBMP on synthetic transient assets and guards them against a baseline:
+ *
+ *   UE4Editor-Cmd Project.uproject -run=GetModelBenchmark [-Cases=10000x1+100000x8+1000000x16+10000000x64]
+ *       [-TextureSize=2048] [-TextureFormat=png] [-FloatPrecision=6] [-Iterations=3]
+ *       [-Baseline=Bench.csv [-Threshold=0.2] [-SaveBaseline]] [-Report=Result.csv]
+ *
+ * A case is <vertices>x<sections>; the mesh is a displaced grid split into sections by rows. Each case reports the
+ * best of Iterations runs as vertices/s and MB/s of obj written, the maps as pixels/s and MB/s of raw pixels, each
+ * with how far used memory rose during the case. With -Baseline, a case whose MB/s drops more than Threshold below
+ * its baseline fails the run; -SaveBaseline writes the results there instead.
+ * Files go to Saved/GetModelBenchmark/.
+ */
+/** Switches of the benchmark besides the export settings it passes on. */
+struct FGetModelBenchmarkOptions
+{
+    FString Cases        = TEXT("10000x1+100000x8+1000000x16+10000000x64");
+    int32   Iterations   = 3;
+    FString ReportPath;
+    FString BaselinePath;
+    float   Threshold     = 0.2f;
+    bool    bSaveBaseline = false;
+
+    /** Keys include their leading dash, so -MyReport= is not taken for -Report=. */
+    void ParseCommandLine(const TCHAR* Params);
+};
+
+UCLASS()
+class UGetModelBenchmarkCommandlet : public UCommandlet
+{
+    GENERATED_BODY()
+
+public:
+    UGetModelBenchmarkCommandlet();
+
+    virtual int32 Main(const FString& Params) override;
+};
@@ -0,0 +1,111 @@
+// Copyright 1998-2019 Epic Games, Inc. All Rights Reserved.
+
+#include "GetModelExportCommandlet.h"
+
+#include "Engine/World.h"
+#include "EngineUtils.h"
+#include "GetModel.h"
+#include "GetModelExportSettings.h"
+#include "Misc/FileHelper.h"
+#include "Misc/PackageName.h"
+#include "Misc/Parse.h"
+#include "Misc/Paths.h"
+#include "Modules/ModuleManager.h"
+#include "UObject/Package.h"
+
+namespace
+{
+bool MatchesFilters(AActor* Actor, const TArray<FString>& ActorPatterns, const TArray<FString>& ActorTags)
+{
+    if (ActorPatterns.Num() && !ActorPatterns.ContainsByPredicate([Actor](const FString& Pattern) { return Actor->GetActorLabel().MatchesWildcard(Pattern) || Actor->GetName().MatchesWildcard(Pattern); })) {
+        return false;
+    }
+    if (ActorTags.Num() && !ActorTags.ContainsByPredicate([Actor](const FString& Tag) { return Actor->ActorHasTag(FName(*Tag)); })) {
+        return false;
+    }
+    return true;
+}
+}  // namespace
+
+UGetModelExportCommandlet::UGetModelExportCommandlet()
+{
+    IsClient        = false;
+    IsEditor        = true;
+    IsServer        = false;
+    LogToConsole    = true;
+    HelpDescription = TEXT("Merges, bakes and exports the static meshes of maps to obj/mtl or glb.");
+    HelpUsage       = TEXT("-run=GetModelExport -Maps=/Game/Maps/A+/Game/Maps/B [-Actors=Pattern+...] [-ActorTags=Tag+...] [-Config=File] [-OutputDir=Dir] [-Setting=Value ...]");
+}
+
+int32 UGetModelExportCommandlet::Main(const FString& Params)
+{
+    // Config lines are appended after the command line, FParse takes the first match.
+    FString AllParams = Params;
+    FString ConfigFile;
+    if (FParse::Value(*Params, TEXT("-Config="), ConfigFile)) {
+        TArray<FString> Lines;
+        if (!FFileHelper::LoadFileToStringArray(Lines, *ConfigFile)) {
+            UE_LOG(LogGetModel, Error, TEXT("Could not read config file %s"), *ConfigFile);
+            return 1;
+        }
+        AllParams = AppendConfigLines(Params, Lines);
+    }
+
+    FGetModelExportSettings Settings;
+    Settings.ParseCommandLine(*AllParams);
+    Settings.bUnattended = true;
+
+    const TArray<FString> MapNames      = ParseList(AllParams, TEXT("-Maps="));
+    const TArray<FString> ActorPatterns = ParseList(AllParams, TEXT("-Actors="));
+    const TArray<FString> ActorTags     = ParseList(AllParams, TEXT("-ActorTags="));
+    if (MapNames.Num() == 0) {
+        UE_LOG(LogGetModel, Error, TEXT("No maps given. Usage: %s"), *HelpUsage);
+        return 1;
+    }
+
+    FGetModelModule& GetModelModule = FModuleManager::LoadModuleChecked<FGetModelModule>("GetModel");
+    const FString    OutputRoot     = Settings.GetSavePath();
+
+    int32 Result = 0;
+    for (const FString& MapName : MapNames) {
+        UPackage* Package = LoadPackage(nullptr, *MapName, LOAD_None);
+        UWorld*   World   = Package ? UWorld::FindWorldInPackage(Package) : nullptr;
+        if (!World) {
+            UE_LOG(LogGetModel, Error, TEXT("Could not load map %s"), *MapName);
+            Result = 1;
+            continue;
+        }
+
+        World->WorldType = EWorldType::Editor;
+        World->AddToRoot();
+
+        const bool bInitializeWorld = !World->bIsWorldInitialized;
+        if (bInitializeWorld) {
+            UWorld::InitializationValues InitValues;
+            InitValues.RequiresHitProxies(false).ShouldSimulatePhysics(false).EnableTraceCollision(false).CreateNavigation(false).CreateAISystem(false).AllowAudioPlayback(false).CreatePhysicsScene(true);
+            World->InitWorld(InitValues);
+        }
+        World->UpdateWorldComponents(true, false);
+
+        TArray<AActor*> Actors;
+        for (TActorIterator<AActor> It(World); It; ++It) {
+            if (MatchesFilters(*It, ActorPatterns, ActorTags)) {
+                Actors.Add(*It);
+            }
+        }
+
+        FGetModelExportSettings MapSettings = Settings;
+        MapSettings.OutputDir               = OutputRoot + FPackageName::GetShortName(MapName);
+
+        UE_LOG(LogGetModel, Display, TEXT("Exporting %d actors of %s to %s"), Actors.Num(), *MapName, *MapSettings.GetSavePath());
+        GetModelModule.ExportActors(Actors, MapSettings);
+
+        if (bInitializeWorld) {
+            World->CleanupWorld();
+        }
+        World->RemoveFromRoot();
+        CollectGarbage(RF_NoFlags);
+    }
+
+    return Result;
+}
@@ -0,0 +1,29 @@
+// Copyright 1998-2019 Epic Games, Inc. All Rights Reserved.
+
+#pragma once
+
+#include "Commandlets/Commandlet.h"
+#include "CoreMinimal.h"
+
+#include "GetModelExportCommandlet.generated.h"
+
+/**
+ * Runs the export of the GetModel tab on whole maps, without Slate or dialogs:
+ *
+ *   UE4Editor-Cmd Project.uproject -run=GetModelExport -Maps=/Game/Maps/A+/Game/Maps/B [-Actors=SM_Rock*+Tree*]
+ *       [-ActorTags=Export] [-Config=Export.ini] [-OutputDir=...] [-Format=glb] [-TextureSize=2048] ...
+ *
+ * Every setting of FGetModelExportSettings can be given as a switch, or one per line ("TextureSize=2048") in the
+ * -Config file; switches on the command line win. Each map is written to its own folder under OutputDir so several
+ * processes can export different maps at once. Material baking renders, so do not pass -nullrhi.
+ */
+UCLASS()
+class UGetModelExportCommandlet : public UCommandlet
+{
+    GENERATED_BODY()
+
+public:
+    UGetModelExportCommandlet();
+
+    virtual int32 Main(const FString& Params) override;
+};
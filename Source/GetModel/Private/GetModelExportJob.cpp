@@ -0,0 +1,222 @@
+// Copyright 1998-2019 Epic Games, Inc. All Rights Reserved.
+
+#include "GetModelExportJob.h"
+
+#include "Async/Async.h"
+#include "Async/ParallelFor.h"
+#include "GetModel.h"
+#include "GetModelAsyncFileWriter.h"
+#include "GetModelVertexTransform.h"
+#include "Misc/FileHelper.h"
+#include "ProfilingDebugging/ScopedTimers.h"
+#include "StaticMeshResources.h"
+
+DECLARE_CYCLE_STAT(TEXT("Write Maps"), STAT_GetModel_WriteMaps, STATGROUP_GetModel);
+DECLARE_CYCLE_STAT(TEXT("Snapshot Source Mesh"), STAT_GetModel_SnapshotSource, STATGROUP_GetModel);
+DECLARE_CYCLE_STAT(TEXT("Optimize Mesh"), STAT_GetModel_OptimizeMesh, STATGROUP_GetModel);
+DECLARE_CYCLE_STAT(TEXT("Write Instances"), STAT_GetModel_WriteInstances, STATGROUP_GetModel);
+DECLARE_CYCLE_STAT(TEXT("Write Obj"), STAT_GetModel_WriteObj, STATGROUP_GetModel);
+DECLARE_CYCLE_STAT(TEXT("Write Mtl"), STAT_GetModel_WriteMtl, STATGROUP_GetModel);
+
+bool WriteMaterialMaps(const FGetModelMapExport& Maps)
+{
+    TArray<bool> Written;
+    Written.SetNumZeroed(Maps.Snapshots.Num());
+    ParallelFor(Maps.Snapshots.Num(), [&Maps, &Written](int32 Index) {
+        TArray<uint8> Bytes;
+        Written[Index] = EncodeTexture(Maps.Snapshots[Index], Maps.Formats[Index], Bytes) && FFileHelper::SaveArrayToFile(Bytes, *Maps.Filenames[Index]);
+        if (!Written[Index]) {
+            UE_LOG(LogGetModel, Warning, TEXT("Could not write map %s"), *Maps.Filenames[Index]);
+        }
+    });
+    return !Maps.bGatherFailed && !Written.Contains(false);
+}
+
+void TransformMeshSnapshot(const FGetModelMeshSnapshot& Source, const FMatrix& Delta, FGetModelMeshSnapshot& OutMesh)
+{
+    const FMatrix Swizzle = GetObjSpaceSwizzle();
+
+    OutMesh.Positions = Source.Positions;
+    OutMesh.Normals   = Source.Normals;
+    TransformVertices(Swizzle * Delta * Swizzle, OutMesh.Positions.GetData(), OutMesh.Normals.GetData(), OutMesh.Positions.Num());
+
+    OutMesh.UVs               = Source.UVs;
+    OutMesh.Indices           = Source.Indices;
+    OutMesh.MaterialTriangles = Source.MaterialTriangles;
+    OutMesh.MaterialNames     = Source.MaterialNames;
+
+    if (Delta.Determinant() < 0.0f) {
+        for (int32 i = 0; i + 2 < OutMesh.Indices.Num(); i += 3) {
+            Swap(OutMesh.Indices[i + 1], OutMesh.Indices[i + 2]);
+        }
+    }
+}
+
+void SnapshotLODResources(const FStaticMeshLODResources& RenderData, const FMatrix& MeshToWorld, const TArray<FString>& SectionMaterials, FGetModelMeshSnapshot& OutMesh)
+{
+    const uint32 VertexCount = RenderData.GetNumVertices();
+    check(VertexCount == RenderData.VertexBuffers.StaticMeshVertexBuffer.GetNumVertices());
+
+    // Read the render vertices, then move them to world space and Lightwave's coordinate system in one pass.
+    OutMesh.Positions.SetNumUninitialized(VertexCount);
+    OutMesh.UVs.SetNumUninitialized(VertexCount);
+    OutMesh.Normals.SetNumUninitialized(VertexCount);
+
+    ParallelFor(VertexCount, [&](int32 i) {
+        // Takes the first UV.
+        const FVector2D UV   = RenderData.VertexBuffers.StaticMeshVertexBuffer.GetVertexUV(i, 0);
+        OutMesh.Positions[i] = RenderData.VertexBuffers.PositionVertexBuffer.VertexPosition(i);
+        OutMesh.Normals[i]   = RenderData.VertexBuffers.StaticMeshVertexBuffer.VertexTangentZ(i);
+
+        // Invert the y-coordinate (Lightwave has their bitmaps upside-down from us).
+        OutMesh.UVs[i] = FVector2D(UV.X, 1.0f - UV.Y);
+    });
+    TransformVertices(MeshToWorld * GetObjSpaceSwizzle(), OutMesh.Positions.GetData(), OutMesh.Normals.GetData(), VertexCount);
+
+    RenderData.IndexBuffer.GetCopy(OutMesh.Indices);
+    check(OutMesh.Indices.Num() % 3 == 0);
+    const int32 NumTriangles = OutMesh.Indices.Num() / 3;
+
+    if (MeshToWorld.Determinant() < 0.0f) {
+        for (int32 i = 0; i + 2 < OutMesh.Indices.Num(); i += 3) {
+            Swap(OutMesh.Indices[i + 1], OutMesh.Indices[i + 2]);
+        }
+    }
+
+    // Resolve up front at which triangle each section's usemtl goes, so face ranges do not depend on each other.
+    // Sections are matched in order; one that starts before the previous match stops the matching, like the
+    // original sequential scan did.
+    for (int32 count = 0; count < RenderData.Sections.Num() && count < SectionMaterials.Num(); count++) {
+        const int32 Triangle = RenderData.Sections[count].FirstIndex / 3;
+        if (Triangle >= NumTriangles || (OutMesh.MaterialTriangles.Num() && Triangle <= OutMesh.MaterialTriangles.Last())) {
+            break;
+        }
+
+        OutMesh.MaterialTriangles.Add(Triangle);
+        OutMesh.MaterialNames.Add(SectionMaterials[count]);
+    }
+}
+
+bool WriteMtlFile(const FString& MtlPath, const TArray<FString>& MaterialNames, const TMap<FString, FString>& MtlEntries)
+{
+    FGetModelObjBuffer Text;
+    TSet<FString>      Written;
+    for (const FString& MaterialName : MaterialNames) {
+        if (Written.Contains(MaterialName)) {
+            continue;
+        }
+        Written.Add(MaterialName);
+
+        Text.AppendString(FString::Printf(TEXT("newmtl %s\r\n"), *MaterialName));
+        for (auto mtlItor = MtlEntries.CreateConstIterator(); mtlItor; ++mtlItor) {
+            Text.AppendString(FString::Printf(TEXT("\t%s %s\r\n"), *mtlItor.Key(), *mtlItor.Value()));
+        }
+        Text.AppendString(TEXT("\r\n\n"));
+    }
+
+    // The whole file is known here, so its size is claimed before the one write.
+    FGetModelAsyncFileWriter MaterialFile(MtlPath, 1);
+    MaterialFile.Preallocate(Text.Data.Num());
+    MaterialFile.Write(Text.Data);
+    return MaterialFile.Close();
+}
+
+bool RunExportJob(FGetModelExportJob& Job)
+{
+    FGetModelExportStats Stats;
+    bool                 bWritten;
+
+    {
+        SCOPE_CYCLE_COUNTER(STAT_GetModel_WriteMaps);
+        FScopedDurationTimer Timer(Stats.WriteMapsSeconds);
+        bWritten = WriteMaterialMaps(Job.Maps);
+    }
+
+    if (Job.SourceLOD) {
+        SCOPE_CYCLE_COUNTER(STAT_GetModel_SnapshotSource);
+        FScopedDurationTimer Timer(Stats.SnapshotSeconds);
+        SnapshotLODResources(*Job.SourceLOD, Job.SourceToWorld, Job.SourceMaterials, Job.Mesh);
+    }
+
+    {
+        FScopedDurationTimer Timer(Stats.WriteMeshSeconds);
+        if (Job.OptimizeSettings.IsSet()) {
+            SCOPE_CYCLE_COUNTER(STAT_GetModel_OptimizeMesh);
+            OptimizeMeshSnapshot(Job.Mesh, Job.OptimizeSettings.GetValue());
+        }
+
+        // Copies are made after the reordering so each keeps its cache friendly order. Too many copies for 32 bit
+        // indices were switched to the table when the job was queued, so its file is listed with the others.
+        if (Job.InstanceSettings.IsSet()) {
+            SCOPE_CYCLE_COUNTER(STAT_GetModel_WriteInstances);
+            const FGetModelInstanceSettings& Instances = Job.InstanceSettings.GetValue();
+            if (!Instances.bExpand || !ExpandMeshInstances(Job.Mesh, Instances.Transforms)) {
+                bWritten &= WriteInstanceTable(Instances.Transforms, GetInstanceTablePath(Job.ObjPath), Job.FloatPrecision);
+            }
+        }
+
+        // The quantized streams index every attribute with the same index, so welding does not apply to them.
+        SCOPE_CYCLE_COUNTER(STAT_GetModel_WriteObj);
+        if (Job.QuantizeSettings.IsSet()) {
+            bWritten &= WriteQuantizedMeshFile(Job.Mesh, Job.ObjPath, Job.QuantizeSettings.GetValue());
+        } else {
+            bWritten &= WriteObjFile(Job.Mesh, Job.ObjPath, Job.FloatPrecision, Job.WeldSettings.GetPtrOrNull());
+        }
+    }
+
+    if (Job.Mesh.MaterialNames.Num()) {
+        SCOPE_CYCLE_COUNTER(STAT_GetModel_WriteMtl);
+        FScopedDurationTimer Timer(Stats.WriteMtlSeconds);
+        bWritten &= WriteMtlFile(Job.MtlPath, Job.Mesh.MaterialNames, Job.Maps.MtlEntries);
+    }
+
+    if (Job.Stats.IsValid()) {
+        if (Job.SourceLOD) {
+            Job.Stats->SnapshotSeconds = Stats.SnapshotSeconds;
+        }
+        Job.Stats->WriteMapsSeconds = Stats.WriteMapsSeconds;
+        Job.Stats->WriteMeshSeconds = Stats.WriteMeshSeconds;
+        Job.Stats->WriteMtlSeconds  = Stats.WriteMtlSeconds;
+    }
+    return bWritten;
+}
+
+FGetModelExportPipeline::FGetModelExportPipeline(int32 InMaxJobsInFlight)
+    : MaxJobsInFlight(FMath::Max(1, InMaxJobsInFlight))
+{
+}
+
+FGetModelExportPipeline::~FGetModelExportPipeline()
+{
+    Flush();
+}
+
+void FGetModelExportPipeline::Enqueue(const TSharedRef<FGetModelExportJob, ESPMode::ThreadSafe>& Job, FOnJobDone OnDone)
+{
+    // Jobs finish roughly in order, so waiting on the oldest frees a slot soonest.
+    while (InFlight.Num() >= MaxJobsInFlight) {
+        FinishOldest();
+    }
+
+    FInFlightJob& Added = InFlight[InFlight.AddDefaulted()];
+    Added.Result        = Async(EAsyncExecution::ThreadPool, [Job]() { return RunExportJob(*Job); });
+    Added.OnDone        = MoveTemp(OnDone);
+}
+
+void FGetModelExportPipeline::Flush()
+{
+    while (InFlight.Num()) {
+        FinishOldest();
+    }
+}
+
+void FGetModelExportPipeline::FinishOldest()
+{
+    FInFlightJob Oldest = MoveTemp(InFlight[0]);
+    InFlight.RemoveAt(0);
+
+    const bool bWritten = Oldest.Result.Get();
+    if (Oldest.OnDone) {
+        Oldest.OnDone(bWritten);
+    }
+}
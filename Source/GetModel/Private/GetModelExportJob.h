@@ -0,0 +1,116 @@
+// Copyright 1998-2019 Epic Games, Inc. All Rights Reserved.
+
+#pragma once
+
+#include "Async/Future.h"
+#include "CoreMinimal.h"
+#include "GetModelExportReport.h"
+#include "GetModelInstanceTable.h"
+#include "GetModelMeshOptimizer.h"
+#include "GetModelObjWriter.h"
+#include "GetModelQuantizedWriter.h"
+#include "GetModelTextureEncoder.h"
+#include "GetModelVertexWelder.h"
+
+struct FStaticMeshLODResources;
+
+/** Baked maps of one merge, read back and ready to be encoded and written. */
+struct FGetModelMapExport
+{
+    /** mtl statement ("map_Kd ", "norm "...) to map file relative to the export folder. */
+    TMap<FString, FString> MtlEntries;
+
+    TArray<FGetModelTextureSnapshot> Snapshots;
+    TArray<EGetModelTextureFormat>   Formats;
+    TArray<FString>                  Filenames;
+
+    /** Set when a bitmap, which is written while gathering, failed; its map is left out of MtlEntries. */
+    bool bGatherFailed = false;
+};
+
+/** Encodes and writes every snapshot of Maps, several at a time. Returns false if any map, bitmaps included, was not written. */
+bool WriteMaterialMaps(const FGetModelMapExport& Maps);
+
+/**
+ * Copies Source moved by Delta. Delta is in engine space while snapshots are in obj space, so the axes are swapped
+ * around it; normals go through the inverse transpose, and a mirroring Delta flips the winding back.
+ */
+void TransformMeshSnapshot(const FGetModelMeshSnapshot& Source, const FMatrix& Delta, FGetModelMeshSnapshot& OutMesh);
+
+/**
+ * Copies one LOD of render data into obj space, moved by MeshToWorld. SectionMaterials names the material of each
+ * section in order. Reads no UObject, so it runs on any thread while the mesh is alive.
+ */
+void SnapshotLODResources(const FStaticMeshLODResources& RenderData, const FMatrix& MeshToWorld, const TArray<FString>& SectionMaterials, FGetModelMeshSnapshot& OutMesh);
+
+/** Writes a .mtl declaring each material of MaterialNames once, all referencing the exported maps. */
+bool WriteMtlFile(const FString& MtlPath, const TArray<FString>& MaterialNames, const TMap<FString, FString>& MtlEntries);
+
+/** Everything left to do for one merged LOD once the UObject work is done: no UObject is referenced. */
+struct FGetModelExportJob
+{
+    FGetModelMeshSnapshot Mesh;
+    FGetModelMapExport    Maps;
+
+    /** The mesh file, a .gmq instead of the obj when QuantizeSettings is set. */
+    FString ObjPath;
+    FString MtlPath;
+    int32   FloatPrecision = 6;
+
+    TOptional<FGetModelWeldSettings>     WeldSettings;
+    TOptional<FGetModelOptimizeSettings> OptimizeSettings;
+    TOptional<FGetModelQuantizeSettings> QuantizeSettings;
+
+    /** Instances of Mesh, written to GetInstanceTablePath(ObjPath) or expanded into the mesh file. */
+    TOptional<FGetModelInstanceSettings> InstanceSettings;
+
+    /**
+     * Render data RunExportJob snapshots into Mesh first, for meshes exported as they are instead of merged. The mesh
+     * must stay alive until the job is done, which holds while the game thread waits on the pipeline.
+     */
+    const FStaticMeshLODResources* SourceLOD = nullptr;
+    FMatrix                        SourceToWorld = FMatrix::Identity;
+    TArray<FString>                SourceMaterials;
+
+    /** Where the write timings go, optional. */
+    TSharedPtr<FGetModelExportStats, ESPMode::ThreadSafe> Stats;
+};
+
+/**
+ * Writes the maps, obj (or gmq) and mtl of Job, snapshotting, reordering or expanding its mesh first when asked to,
+ * and its instance table. Returns false if any of the files was not written.
+ */
+bool RunExportJob(FGetModelExportJob& Job);
+
+/**
+ * Runs export jobs on the thread pool while the game thread merges and bakes the next component.
+ * At most MaxJobsInFlight jobs are queued or running; Enqueue blocks on the oldest one beyond that, which caps the
+ * memory held by mesh and pixel snapshots.
+ */
+class FGetModelExportPipeline
+{
+public:
+    /** Called with RunExportJob's result once the job is done, on the thread calling Enqueue or Flush. */
+    typedef TFunction<void(bool bWritten)> FOnJobDone;
+
+    explicit FGetModelExportPipeline(int32 InMaxJobsInFlight = 2);
+    ~FGetModelExportPipeline();
+
+    void Enqueue(const TSharedRef<FGetModelExportJob, ESPMode::ThreadSafe>& Job, FOnJobDone OnDone = nullptr);
+
+    /** Waits for every queued job. */
+    void Flush();
+
+private:
+    struct FInFlightJob
+    {
+        TFuture<bool> Result;
+        FOnJobDone    OnDone;
+    };
+
+    /** Waits for the oldest job and hands its result on. */
+    void FinishOldest();
+
+    TArray<FInFlightJob> InFlight;
+    int32                MaxJobsInFlight;
+};
@@ -0,0 +1,61 @@
+// Copyright 1998-2019 Epic Games, Inc. All Rights Reserved.
+
+#include "GetModelExportManifest.h"
+
+#include "HAL/FileManager.h"
+#include "Misc/FileHelper.h"
+
+FGetModelExportManifest::FGetModelExportManifest(const FString& InFilename)
+    : Filename(InFilename)
+{
+    TArray<FString> Lines;
+    if (!FFileHelper::LoadFileToStringArray(Lines, *Filename)) {
+        return;
+    }
+
+    for (const FString& Line : Lines) {
+        TArray<FString> Fields;
+        Line.ParseIntoArray(Fields, TEXT("\t"), false);
+        if (Fields.Num() < 2) {
+            continue;
+        }
+
+        FEntry& Entry = Entries.FindOrAdd(Fields[0]);
+        Entry.Hash    = Fields[1];
+        Entry.Files.Reset();
+        for (int32 FieldIndex = 2; FieldIndex < Fields.Num(); FieldIndex++) {
+            Entry.Files.Add(Fields[FieldIndex]);
+        }
+    }
+}
+
+bool FGetModelExportManifest::IsUpToDate(const FString& Key, const FString& Hash) const
+{
+    const FEntry* Entry = Entries.Find(Key);
+    if (!Entry || Entry->Hash != Hash) {
+        return false;
+    }
+
+    for (const FString& File : Entry->Files) {
+        if (!IFileManager::Get().FileExists(*File)) {
+            return false;
+        }
+    }
+    return true;
+}
+
+void FGetModelExportManifest::Record(const FString& Key, const FString& Hash, const TArray<FString>& Files)
+{
+    FEntry& Entry = Entries.FindOrAdd(Key);
+    Entry.Hash    = Hash;
+    Entry.Files   = Files;
+}
+
+bool FGetModelExportManifest::Save() const
+{
+    TArray<FString> Lines;
+    for (const auto& Pair : Entries) {
+        Lines.Add(Pair.Key + TEXT("\t") + Pair.Value.Hash + (Pair.Value.Files.Num() ? TEXT("\t") + FString::Join(Pair.Value.Files, TEXT("\t")) : FString()));
+    }
+    return FFileHelper::SaveStringArrayToFile(Lines, *Filename);
+}
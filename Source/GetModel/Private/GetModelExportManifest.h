@@ -0,0 +1,33 @@
+// Copyright 1998-2019 Epic Games, Inc. All Rights Reserved.
+
+#pragma once
+
+#include "CoreMinimal.h"
+
+/**
+ * Remembers, per exported output, a hash of everything that went into it and the files it produced.
+ * Stored as tab separated text next to the exported files: key, hash, then the file list.
+ */
+class FGetModelExportManifest
+{
+public:
+    /** Loads InFilename if it exists. */
+    explicit FGetModelExportManifest(const FString& InFilename);
+
+    /** True when Key was last exported with the same Hash and all of its files are still on disk. */
+    bool IsUpToDate(const FString& Key, const FString& Hash) const;
+
+    void Record(const FString& Key, const FString& Hash, const TArray<FString>& Files);
+
+    bool Save() const;
+
+private:
+    struct FEntry
+    {
+        FString         Hash;
+        TArray<FString> Files;
+    };
+
+    FString               Filename;
+    TMap<FString, FEntry> Entries;
+};
@@ -0,0 +1,50 @@
+// Copyright 1998-2019 Epic Games, Inc. All Rights Reserved.
+
+#include "GetModelExportReport.h"
+
+#include "HAL/FileManager.h"
+#include "Misc/FileHelper.h"
+
+FGetModelExportReport::FGetModelExportReport()
+    : StartSeconds(FPlatformTime::Seconds())
+{
+}
+
+TSharedRef<FGetModelExportStats, ESPMode::ThreadSafe> FGetModelExportReport::AddRow(const FString& Name, int32 LOD, const TCHAR* Status)
+{
+    TSharedRef<FGetModelExportStats, ESPMode::ThreadSafe> Row = MakeShared<FGetModelExportStats, ESPMode::ThreadSafe>();
+    Row->Name   = Name;
+    Row->LOD    = LOD;
+    Row->Status = Status;
+    Rows.Add(Row);
+    return Row;
+}
+
+bool FGetModelExportReport::SaveCsv(const FString& Filename) const
+{
+    auto ToMs = [](double Seconds) { return FString::Printf(TEXT("%.1f"), Seconds * 1000.0); };
+
+    TArray<FString> Lines;
+    Lines.Add(TEXT("Name,LOD,Status,Vertices,Triangles,Textures,MergeMs,GatherMapsMs,SnapshotMs,WriteMapsMs,WriteMeshMs,WriteMtlMs,Bytes"));
+
+    int64 TotalBytes = 0;
+    for (const TSharedRef<FGetModelExportStats, ESPMode::ThreadSafe>& Row : Rows) {
+        int64 Bytes = 0;
+        for (const FString& File : Row->Files) {
+            Bytes += FMath::Max<int64>(IFileManager::Get().FileSize(*File), 0);
+        }
+        TotalBytes += Bytes;
+
+        TArray<FString> TextureSizes;
+        for (const FIntPoint& Size : Row->TextureSizes) {
+            TextureSizes.Add(FString::Printf(TEXT("%dx%d"), Size.X, Size.Y));
+        }
+
+        Lines.Add(FString::Join(TArray<FString>{Row->Name, FString::FromInt(Row->LOD), Row->Status, FString::FromInt(Row->Vertices), FString::FromInt(Row->Triangles), FString::Join(TextureSizes, TEXT(" ")), ToMs(Row->MergeSeconds), ToMs(Row->GatherMapsSeconds), ToMs(Row->SnapshotSeconds), ToMs(Row->WriteMapsSeconds), ToMs(Row->WriteMeshSeconds), ToMs(Row->WriteMtlSeconds), FString::Printf(TEXT("%lld"), Bytes)}, TEXT(",")));
+    }
+
+    // Stages overlap, so the wall time is less than the sum of the columns.
+    Lines.Add(FString::Printf(TEXT("Total,,wall %s ms,,,,,,,,,,%lld"), *ToMs(FPlatformTime::Seconds() - StartSeconds), TotalBytes));
+
+    return FFileHelper::SaveStringArrayToFile(Lines, *Filename);
+}
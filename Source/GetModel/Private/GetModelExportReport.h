@@ -0,0 +1,48 @@
+// Copyright 1998-2019 Epic Games, Inc. All Rights Reserved.
+
+#pragma once
+
+#include "CoreMinimal.h"
+#include "Stats/Stats.h"
+
+DECLARE_STATS_GROUP(TEXT("GetModel"), STATGROUP_GetModel, STATCAT_Advanced);
+
+/** Timings and sizes of one exported LOD, one line of the run report. */
+struct FGetModelExportStats
+{
+    FString Name;
+    int32   LOD = 0;
+    FString Status;
+
+    int32             Vertices  = 0;
+    int32             Triangles = 0;
+    TArray<FIntPoint> TextureSizes;
+
+    double MergeSeconds      = 0.0;
+    double GatherMapsSeconds = 0.0;
+    double SnapshotSeconds   = 0.0;
+
+    /** Filled by the export job on a worker thread, read once the pipeline is flushed. */
+    double WriteMapsSeconds = 0.0;
+    double WriteMeshSeconds = 0.0;
+    double WriteMtlSeconds  = 0.0;
+
+    /** Files this LOD wrote itself; shared maps only count for the LOD that baked them. */
+    TArray<FString> Files;
+};
+
+/** Collects one FGetModelExportStats per exported LOD and writes them as csv. */
+class FGetModelExportReport
+{
+public:
+    FGetModelExportReport();
+
+    TSharedRef<FGetModelExportStats, ESPMode::ThreadSafe> AddRow(const FString& Name, int32 LOD, const TCHAR* Status);
+
+    /** Sizes the files of every row, so only call it once everything is written. */
+    bool SaveCsv(const FString& Filename) const;
+
+private:
+    TArray<TSharedRef<FGetModelExportStats, ESPMode::ThreadSafe>> Rows;
+    double                                                        StartSeconds;
+};
@@ -0,0 +1,127 @@
+// Copyright 1998-2019 Epic Games, Inc. All Rights Reserved.
+
+#include "GetModelExportSettings.h"
+
+#include "Misc/Parse.h"
+#include "Misc/Paths.h"
+
+namespace
+{
+void ParseTextureFormat(const TCHAR* Params, const TCHAR* Match, EGetModelTextureFormat& Value)
+{
+    FString Name;
+    if (!FParse::Value(Params, Match, Name)) {
+        return;
+    }
+
+    // "png16" for 16 bit png, otherwise the file extension.
+    if (Name == TEXT("png16")) {
+        Value = EGetModelTextureFormat::PNG16;
+        return;
+    }
+    for (int32 Format = 0; Format < GetTextureFormatNames().Num(); Format++) {
+        if (Name == GetTextureFormatExtension((EGetModelTextureFormat)Format)) {
+            Value = (EGetModelTextureFormat)Format;
+            return;
+        }
+    }
+}
+}  // namespace
+
+void FGetModelExportSettings::ParseCommandLine(const TCHAR* Params)
+{
+    FString FormatName;
+    if (FParse::Value(Params, TEXT("-Format="), FormatName)) {
+        Format = FormatName == TEXT("glb") ? EGetModelExportFormat::Glb : FormatName == TEXT("gmq") ? EGetModelExportFormat::Gmq : EGetModelExportFormat::Obj;
+    }
+    FParse::Bool(Params, TEXT("-Export="), bExport);
+    FParse::Value(Params, TEXT("-OutputDir="), OutputDir);
+
+    int32 Size = 0;
+    if (FParse::Value(Params, TEXT("-TextureSize="), Size)) {
+        TextureSize = FIntPoint(Size, Size);
+    }
+    FParse::Value(Params, TEXT("-TextureSizeX="), TextureSize.X);
+    FParse::Value(Params, TEXT("-TextureSizeY="), TextureSize.Y);
+    FParse::Value(Params, TEXT("-LODTextureScale="), LODTextureScale);
+    FParse::Value(Params, TEXT("-MinLODTextureSize="), MinLODTextureSize);
+    FParse::Bool(Params, TEXT("-UseVertexDataForBakingMaterial="), bUseVertexDataForBakingMaterial);
+    FParse::Bool(Params, TEXT("-MergePhysicsData="), bMergePhysicsData);
+    FParse::Bool(Params, TEXT("-NormalMap="), bNormalMap);
+    FParse::Bool(Params, TEXT("-MRSMap="), bMRSMap);
+    FParse::Bool(Params, TEXT("-OpacityMap="), bOpacityMap);
+    FParse::Bool(Params, TEXT("-EmissiveMap="), bEmissiveMap);
+
+    ParseTextureFormat(Params, TEXT("-TextureFormat="), TextureFormat);
+    ParseTextureFormat(Params, TEXT("-NormalMapFormat="), NormalMapFormat);
+
+    FParse::Value(Params, TEXT("-FloatPrecision="), FloatPrecision);
+    FParse::Bool(Params, TEXT("-WeldVertices="), bWeldVertices);
+    FParse::Value(Params, TEXT("-WeldEpsilon="), WeldEpsilon);
+    FParse::Bool(Params, TEXT("-OptimizeVertexCache="), bOptimizeVertexCache);
+    FParse::Bool(Params, TEXT("-OptimizeOverdraw="), bOptimizeOverdraw);
+    FParse::Value(Params, TEXT("-QuantizedNormalBits="), QuantizedNormalBits);
+
+    FParse::Bool(Params, TEXT("-InstancingMultiActors="), bInstancingMultiActors);
+    FParse::Bool(Params, TEXT("-SkipUnchanged="), bSkipUnchanged);
+    FParse::Bool(Params, TEXT("-ShareBakedMaps="), bShareBakedMaps);
+    FParse::Value(Params, TEXT("-BakeLOD="), BakeLOD);
+    FParse::Bool(Params, TEXT("-BatchMerge="), bBatchMerge);
+    FParse::Value(Params, TEXT("-BatchSize="), BatchSize);
+    FParse::Value(Params, TEXT("-BatchDistance="), BatchDistance);
+    FParse::Value(Params, TEXT("-TileSize="), TileSize);
+    FParse::Bool(Params, TEXT("-TransientMerge="), bTransientMerge);
+    FParse::Bool(Params, TEXT("-FastGeometry="), bFastGeometry);
+    FParse::Bool(Params, TEXT("-InstanceTables="), bInstanceTables);
+    FParse::Bool(Params, TEXT("-ExpandInstances="), bExpandInstances);
+    FParse::Bool(Params, TEXT("-ExportLandscapes="), bExportLandscapes);
+    FParse::Value(Params, TEXT("-LandscapeLOD="), LandscapeLOD);
+    FParse::Bool(Params, TEXT("-LandscapeWeightmaps="), bLandscapeWeightmaps);
+
+    TextureSize         = FIntPoint(FMath::Clamp(TextureSize.X, 1, 16384), FMath::Clamp(TextureSize.Y, 1, 16384));
+    LODTextureScale     = FMath::Clamp(LODTextureScale, 0.05f, 1.0f);
+    MinLODTextureSize   = FMath::Clamp(MinLODTextureSize, 1, 16384);
+    FloatPrecision      = FMath::Clamp(FloatPrecision, -1, 9);
+    QuantizedNormalBits = QuantizedNormalBits > 8 ? 16 : 8;
+    BatchSize           = FMath::Max(BatchSize, 2);
+}
+
+FString FGetModelExportSettings::GetSavePath() const
+{
+    FString SavePath = OutputDir.IsEmpty() ? FPaths::ProjectContentDir() + TEXT("GetObjandMaterial/") : OutputDir;
+    SavePath         = FPaths::ConvertRelativePathToFull(SavePath);
+    if (!SavePath.EndsWith(TEXT("/"))) {
+        SavePath += TEXT("/");
+    }
+    return SavePath;
+}
+
+TArray<FString> ParseList(const FString& Params, const TCHAR* Match)
+{
+    FString         Value;
+    TArray<FString> Items;
+    if (FParse::Value(*Params, Match, Value)) {
+        Value.ParseIntoArray(Items, TEXT("+"), true);
+    }
+    return Items;
+}
+
+FString AppendConfigLines(const FString& Params, const TArray<FString>& Lines)
+{
+    FString AllParams = Params;
+    for (FString Line : Lines) {
+        Line.TrimStartAndEndInline();
+        if (Line.IsEmpty() || Line.StartsWith(TEXT(";")) || Line.StartsWith(TEXT("#"))) {
+            continue;
+        }
+
+        FString Key;
+        FString Value;
+        if (Line.Split(TEXT("="), &Key, &Value) && !Value.StartsWith(TEXT("\"")) && Value.Contains(TEXT(" "))) {
+            AllParams += FString::Printf(TEXT(" -%s=\"%s\""), *Key, *Value);
+        } else {
+            AllParams += TEXT(" -") + Line;
+        }
+    }
+    return AllParams;
+}
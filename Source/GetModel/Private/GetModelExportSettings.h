@@ -0,0 +1,105 @@
+// Copyright 1998-2019 Epic Games, Inc. All Rights Reserved.
+
+#pragma once
+
+#include "CoreMinimal.h"
+#include "GetModel.h"
+#include "GetModelTextureEncoder.h"
+
+/** Everything an export run reads, filled from the tab's widgets or from a commandlet's parameters. */
+struct FGetModelExportSettings
+{
+    /** Write files; otherwise only the merged assets are created in the project. */
+    bool                  bExport = true;
+    EGetModelExportFormat Format  = EGetModelExportFormat::Obj;
+
+    /** Folder the exported files and maps/ go into, Content/GetObjandMaterial/ when empty. */
+    FString OutputDir;
+
+    FIntPoint TextureSize                     = FIntPoint(1024, 1024);
+    bool      bUseVertexDataForBakingMaterial = true;
+    bool      bMergePhysicsData               = false;
+    bool      bNormalMap                      = true;
+    bool      bMRSMap                         = true;
+    bool      bOpacityMap                     = true;
+    bool      bEmissiveMap                    = false;
+
+    /**
+     * LOD n bakes at TextureSize * LODTextureScale^n, not below MinLODTextureSize; 1 bakes every LOD at full size.
+     * Maps shared through bShareBakedMaps serve LOD 0 too, so they bake at full size whatever BakeLOD is.
+     */
+    float LODTextureScale   = 1.0f;
+    int32 MinLODTextureSize = 64;
+
+    EGetModelTextureFormat TextureFormat   = EGetModelTextureFormat::BMP;
+    EGetModelTextureFormat NormalMapFormat = EGetModelTextureFormat::BMP;
+
+    int32 FloatPrecision       = 6;
+    bool  bWeldVertices        = false;
+    float WeldEpsilon          = 0.01f;
+    bool  bOptimizeVertexCache = false;
+    bool  bOptimizeOverdraw    = false;
+    int32 QuantizedNormalBits  = 8;
+
+    bool  bInstancingMultiActors = true;
+    bool  bSkipUnchanged         = true;
+    bool  bShareBakedMaps        = false;
+    int32 BakeLOD                = 0;
+    bool  bBatchMerge            = false;
+    int32 BatchSize              = 16;
+    float BatchDistance          = 0.0f;
+
+    /**
+     * Side of the squares the selection is split into by component bounds, exported one after another into
+     * Tile_<X>_<Y>/ folders with the merged assets released in between. When exporting, tiles always merge like
+     * bTransientMerge, so no merged asset is kept in the project. 0 exports the whole selection at once.
+     */
+    float TileSize = 0.0f;
+
+    /** When exporting, merge into the transient package instead of creating assets in the project. */
+    bool bTransientMerge = false;
+
+    /**
+     * Write each component's own LODs with its material names, without merging or baking maps. Instanced components
+     * get every instance copied into the mesh, or an instance table with bInstanceTables. Not for glb.
+     */
+    bool bFastGeometry = false;
+
+    /**
+     * Export instanced static mesh components (foliage, HISM) as their mesh merged once at the origin, plus
+     * <mesh>_Instances.csv with the transform of each instance. With bExpandInstances, every instance's copy goes
+     * into the mesh file instead. Not for glb.
+     */
+    bool bInstanceTables  = false;
+    bool bExpandInstances = false;
+
+    /**
+     * Stream selected landscapes into <Landscape>_LOD<n>.obj, sampled at LandscapeLOD, optionally with a weightmap
+     * tile per component and paint layer. Written as obj whatever the format.
+     */
+    bool  bExportLandscapes    = false;
+    int32 LandscapeLOD         = 0;
+    bool  bLandscapeWeightmaps = false;
+
+    /** No progress dialogs, content browser sync or closing message box. */
+    bool bUnattended = false;
+
+    /**
+     * Overrides the settings given as switches, named like the members without their prefix:
+     * -Format=glb -TextureSize=2048 -NormalMap=false -TextureFormat=png -OutputDir=D:/Export ...
+     * Switches are matched with their dash, so one never matches inside a longer one (-TextureFormat= is not -Format=).
+     */
+    void ParseCommandLine(const TCHAR* Params);
+
+    /** OutputDir, or the default folder, with a trailing slash. */
+    FString GetSavePath() const;
+};
+
+/** The '+' separated items of the switch Match ("-Maps=/Game/A+/Game/B"), empty when it is not given. */
+TArray<FString> ParseList(const FString& Params, const TCHAR* Match);
+
+/**
+ * Config lines ("Key=Value", ';' and '#' start comments) appended to Params as switches, where FParse finds them after
+ * the command line's own. Values with spaces are quoted, FParse would stop at the first one otherwise.
+ */
+FString AppendConfigLines(const FString& Params, const TArray<FString>& Lines);
@@ -0,0 +1,82 @@
+// Copyright 1998-2019 Epic Games, Inc. All Rights Reserved.
+
+#include "GetModelExporterRegistry.h"
+
+#include "Exporters/Exporter.h"
+#include "Modules/ModuleManager.h"
+#include "UObject/Package.h"
+#include "UObject/UObjectIterator.h"
+
+FGetModelExporterRegistry::FGetModelExporterRegistry()
+    : bDirty(true)
+{
+    ModulesChangedHandle = FModuleManager::Get().OnModulesChanged().AddRaw(this, &FGetModelExporterRegistry::OnModulesChanged);
+}
+
+FGetModelExporterRegistry::~FGetModelExporterRegistry()
+{
+    FModuleManager::Get().OnModulesChanged().Remove(ModulesChangedHandle);
+}
+
+UExporter* FGetModelExporterRegistry::FindExporter(const UObject* Object, const FString& Extension)
+{
+    if (!Object) {
+        return nullptr;
+    }
+
+    if (bDirty) {
+        Rebuild();
+    }
+
+    // Exporters register the most derived class they handle, e.g. UTexture2D, so walk up from the object's class.
+    const FString Key = Extension.ToUpper();
+    for (const UClass* Class = Object->GetClass(); Class; Class = Class->GetSuperClass()) {
+        if (UExporter* const* Exporter = ExportersByClassAndExtension.Find(MakeTuple(Class, Key))) {
+            return *Exporter;
+        }
+    }
+
+    return nullptr;
+}
+
+void FGetModelExporterRegistry::Invalidate()
+{
+    Exporters.Empty();
+    ExportersByClassAndExtension.Empty();
+    bDirty = true;
+}
+
+void FGetModelExporterRegistry::Rebuild()
+{
+    Invalidate();
+
+    UPackage* TransientPackage = GetTransientPackage();
+    for (TObjectIterator<UClass> It; It; ++It) {
+        if (It->IsChildOf(UExporter::StaticClass()) && !It->HasAnyClassFlags(CLASS_Abstract)) {
+            UExporter* Exporter = NewObject<UExporter>(TransientPackage, *It);
+            Exporters.Add(Exporter);
+
+            // First registered exporter wins when several write the same format.
+            for (const FString& FormatExtension : Exporter->FormatExtension) {
+                const TPair<const UClass*, FString> Key = MakeTuple((const UClass*)Exporter->SupportedClass, FormatExtension.ToUpper());
+                if (!ExportersByClassAndExtension.Contains(Key)) {
+                    ExportersByClassAndExtension.Add(Key, Exporter);
+                }
+            }
+        }
+    }
+
+    bDirty = false;
+}
+
+void FGetModelExporterRegistry::OnModulesChanged(FName ModuleName, EModuleChangeReason Reason)
+{
+    if (Reason == EModuleChangeReason::ModuleLoaded) {
+        bDirty = true;
+    }
+}
+
+void FGetModelExporterRegistry::AddReferencedObjects(FReferenceCollector& Collector)
+{
+    Collector.AddReferencedObjects(Exporters);
+}
@@ -0,0 +1,40 @@
+// Copyright 1998-2019 Epic Games, Inc. All Rights Reserved.
+
+#pragma once
+
+#include "CoreMinimal.h"
+#include "Modules/ModuleManager.h"
+#include "UObject/GCObject.h"
+
+class UExporter;
+
+/**
+ * One instance of every concrete UExporter, indexed by supported class and file extension.
+ * Built at module startup and again only after a module was loaded, since that is the only time new exporter classes appear.
+ */
+class FGetModelExporterRegistry : public FGCObject
+{
+public:
+    FGetModelExporterRegistry();
+    virtual ~FGetModelExporterRegistry();
+
+    /** Exporter writing Extension (case-insensitive, without dot) for Object's class or its closest parent class. */
+    UExporter* FindExporter(const UObject* Object, const FString& Extension);
+
+    /** Instantiates every concrete exporter class and indexes it. */
+    void Rebuild();
+
+    /** Drops the exporters, the next lookup rebuilds them. */
+    void Invalidate();
+
+    // FGCObject interface
+    virtual void AddReferencedObjects(FReferenceCollector& Collector) override;
+
+private:
+    void OnModulesChanged(FName ModuleName, EModuleChangeReason Reason);
+
+    TArray<UExporter*>                              Exporters;
+    TMap<TPair<const UClass*, FString>, UExporter*> ExportersByClassAndExtension;
+    bool                                            bDirty;
+    FDelegateHandle                                 ModulesChangedHandle;
+};
@@ -0,0 +1,173 @@
+// Copyright 1998-2019 Epic Games, Inc. All Rights Reserved.
+
+#include "GetModelGltfWriter.h"
+
+#include "HAL/FileManager.h"
+#include "Serialization/Archive.h"
+
+namespace
+{
+const uint32 GlbMagic     = 0x46546C67;  // "glTF"
+const uint32 GlbVersion   = 2;
+const uint32 GlbChunkJson = 0x4E4F534A;  // "JSON"
+const uint32 GlbChunkBin  = 0x004E4942;  // "BIN\0"
+
+FString JoinObjects(const TArray<FString>& Objects)
+{
+    return TEXT("[") + FString::Join(Objects, TEXT(",")) + TEXT("]");
+}
+}  // namespace
+
+int32 FGetModelGlbWriter::AddBufferView(const void* Data, int64 NumBytes, ETarget Target)
+{
+    const int32 BufferView = ReserveBufferView(NumBytes, Target);
+    FMemory::Memcpy(GetBufferViewData(BufferView), Data, NumBytes);
+    return BufferView;
+}
+
+int32 FGetModelGlbWriter::ReserveBufferView(int64 NumBytes, ETarget Target)
+{
+    // Every view starts 4-byte aligned, which covers all component types used here.
+    BinaryChunk.AddZeroed(Align(BinaryChunk.Num(), 4) - BinaryChunk.Num());
+
+    FBufferView View;
+    View.Offset   = BinaryChunk.Num();
+    View.NumBytes = NumBytes;
+    View.Target   = Target;
+    BinaryChunk.AddUninitialized(NumBytes);
+
+    return BufferViews.Add(View);
+}
+
+uint8* FGetModelGlbWriter::GetBufferViewData(int32 BufferView)
+{
+    return BinaryChunk.GetData() + BufferViews[BufferView].Offset;
+}
+
+int32 FGetModelGlbWriter::AddAccessor(int32 BufferView, int64 ByteOffset, EComponentType ComponentType, int32 Count, const TCHAR* Type, const FString& MinMax)
+{
+    FString Accessor = FString::Printf(TEXT("{\"bufferView\":%d,\"byteOffset\":%lld,\"componentType\":%d,\"count\":%d,\"type\":\"%s\""), BufferView, ByteOffset, (int32)ComponentType, Count, Type);
+    if (!MinMax.IsEmpty()) {
+        Accessor += TEXT(",") + MinMax;
+    }
+    Accessor += TEXT("}");
+
+    return Accessors.Add(Accessor);
+}
+
+int32 FGetModelGlbWriter::AddPngTexture(const TArray<uint8>& Png, const FString& Name)
+{
+    const int32 BufferView = AddBufferView(Png.GetData(), Png.Num());
+    const int32 Image      = Images.Add(FString::Printf(TEXT("{\"name\":%s,\"bufferView\":%d,\"mimeType\":\"image/png\"}"), *QuoteString(Name), BufferView));
+    return Textures.Add(FString::Printf(TEXT("{\"source\":%d}"), Image));
+}
+
+int32 FGetModelGlbWriter::AddMaterial(const FString& MaterialJson)
+{
+    return Materials.Add(MaterialJson);
+}
+
+void FGetModelGlbWriter::AddPrimitive(const FString& PrimitiveJson)
+{
+    Primitives.Add(PrimitiveJson);
+}
+
+FString FGetModelGlbWriter::FormatFloats(const float* Values, int32 Num)
+{
+    TArray<FString> Text;
+    for (int32 i = 0; i < Num; i++) {
+        Text.Add(FString::Printf(TEXT("%.9g"), Values[i]));
+    }
+    return TEXT("[") + FString::Join(Text, TEXT(",")) + TEXT("]");
+}
+
+FString FGetModelGlbWriter::QuoteString(const FString& Text)
+{
+    FString Quoted = TEXT("\"");
+    for (TCHAR Char : Text) {
+        if (Char == TEXT('"') || Char == TEXT('\\')) {
+            Quoted += TEXT('\\');
+            Quoted += Char;
+        } else if (Char < 0x20) {
+            Quoted += FString::Printf(TEXT("\\u%04x"), (int32)Char);
+        } else {
+            Quoted += Char;
+        }
+    }
+    return Quoted + TEXT("\"");
+}
+
+bool FGetModelGlbWriter::SaveToFile(const FString& Filename, const FString& MeshName, float NodeScale) const
+{
+    TArray<FString> Views;
+    for (const FBufferView& View : BufferViews) {
+        FString ViewJson = FString::Printf(TEXT("{\"buffer\":0,\"byteOffset\":%lld,\"byteLength\":%lld"), View.Offset, View.NumBytes);
+        if (View.Target != NoTarget) {
+            ViewJson += FString::Printf(TEXT(",\"target\":%d"), View.Target);
+        }
+        Views.Add(ViewJson + TEXT("}"));
+    }
+
+    const float Scale[3] = {NodeScale, NodeScale, NodeScale};
+
+    FString Json = TEXT("{\"asset\":{\"version\":\"2.0\",\"generator\":\"UnrealEd GetModel exporter\"}");
+    if (Primitives.Num()) {
+        const FString Name = QuoteString(MeshName);
+        Json += TEXT(",\"scene\":0,\"scenes\":[{\"nodes\":[0]}]");
+        Json += FString::Printf(TEXT(",\"nodes\":[{\"name\":%s,\"mesh\":0,\"scale\":%s}]"), *Name, *FormatFloats(Scale, 3));
+        Json += FString::Printf(TEXT(",\"meshes\":[{\"name\":%s,\"primitives\":%s}]"), *Name, *JoinObjects(Primitives));
+    }
+    if (Materials.Num()) {
+        Json += TEXT(",\"materials\":") + JoinObjects(Materials);
+    }
+    if (Textures.Num()) {
+        Json += TEXT(",\"textures\":") + JoinObjects(Textures);
+        Json += TEXT(",\"images\":") + JoinObjects(Images);
+    }
+    if (Accessors.Num()) {
+        Json += TEXT(",\"accessors\":") + JoinObjects(Accessors);
+    }
+    if (BinaryChunk.Num()) {
+        Json += TEXT(",\"bufferViews\":") + JoinObjects(Views);
+        Json += FString::Printf(TEXT(",\"buffers\":[{\"byteLength\":%d}]"), BinaryChunk.Num());
+    }
+    Json += TEXT("}");
+
+    // Json chunk is padded with spaces, binary chunk with zeros, both to 4 bytes.
+    FTCHARToUTF8  JsonUtf8(*Json);
+    TArray<uint8> JsonChunk;
+    JsonChunk.Append((const uint8*)JsonUtf8.Get(), JsonUtf8.Length());
+    while (JsonChunk.Num() % 4) {
+        JsonChunk.Add(' ');
+    }
+    const uint32 BinaryLength = Align(BinaryChunk.Num(), 4);
+
+    uint32 Header[3];
+    Header[0] = GlbMagic;
+    Header[1] = GlbVersion;
+    Header[2] = sizeof(Header) + 8 + JsonChunk.Num() + (BinaryLength ? 8 + BinaryLength : 0);
+
+    FArchive* GlbFile = IFileManager::Get().CreateFileWriter(*Filename);
+    if (!GlbFile) {
+        return false;
+    }
+
+    uint32 ChunkHeader[2] = {(uint32)JsonChunk.Num(), GlbChunkJson};
+    GlbFile->Serialize(Header, sizeof(Header));
+    GlbFile->Serialize(ChunkHeader, sizeof(ChunkHeader));
+    GlbFile->Serialize(JsonChunk.GetData(), JsonChunk.Num());
+
+    if (BinaryLength) {
+        ChunkHeader[0] = BinaryLength;
+        ChunkHeader[1] = GlbChunkBin;
+        GlbFile->Serialize(ChunkHeader, sizeof(ChunkHeader));
+        GlbFile->Serialize(const_cast<uint8*>(BinaryChunk.GetData()), BinaryChunk.Num());
+
+        uint8 Padding[4] = {0, 0, 0, 0};
+        GlbFile->Serialize(Padding, BinaryLength - BinaryChunk.Num());
+    }
+
+    const bool bSuccess = !GlbFile->IsError();
+    delete GlbFile;
+    return bSuccess;
+}
@@ -0,0 +1,73 @@
+// Copyright 1998-2019 Epic Games, Inc. All Rights Reserved.
+
+#pragma once
+
+#include "CoreMinimal.h"
+
+/**
+ * Assembles a binary glTF 2.0 (.glb) file: raw attribute data goes into one binary chunk as buffer views and the
+ * JSON chunk only describes them.
+ */
+class FGetModelGlbWriter
+{
+public:
+    enum EComponentType
+    {
+        UnsignedShort = 5123,
+        UnsignedInt   = 5125,
+        Float         = 5126,
+    };
+
+    enum ETarget
+    {
+        NoTarget           = 0,
+        ArrayBuffer        = 34962,
+        ElementArrayBuffer = 34963,
+    };
+
+    /** Copies Data into the binary chunk and returns the buffer view index. */
+    int32 AddBufferView(const void* Data, int64 NumBytes, ETarget Target = NoTarget);
+
+    /** Reserves NumBytes in the binary chunk for the caller to fill through GetBufferViewData. */
+    int32  ReserveBufferView(int64 NumBytes, ETarget Target = NoTarget);
+    uint8* GetBufferViewData(int32 BufferView);
+
+    /** Type is "SCALAR", "VEC2", "VEC3"... MinMax is optional "\"min\":[..],\"max\":[..]" json. */
+    int32 AddAccessor(int32 BufferView, int64 ByteOffset, EComponentType ComponentType, int32 Count, const TCHAR* Type, const FString& MinMax = FString());
+
+    /** Embeds an encoded png and returns the texture index referring to it. */
+    int32 AddPngTexture(const TArray<uint8>& Png, const FString& Name);
+
+    /** Material json object, returns the material index. */
+    int32 AddMaterial(const FString& MaterialJson);
+
+    /** Primitive json object of the single mesh. */
+    void AddPrimitive(const FString& PrimitiveJson);
+
+    /**
+     * Writes header, json and binary chunk. The node scale converts from Unreal units. Without primitives no node or
+     * mesh is written, and without binary data no buffer, since glTF forbids empty meshes and buffers.
+     */
+    bool SaveToFile(const FString& Filename, const FString& MeshName, float NodeScale) const;
+
+    static FString FormatFloats(const float* Values, int32 Num);
+
+    /** Quoted json string, with quotes, backslashes and control characters escaped. */
+    static FString QuoteString(const FString& Text);
+
+private:
+    struct FBufferView
+    {
+        int64 Offset;
+        int64 NumBytes;
+        int32 Target;
+    };
+
+    TArray<uint8>       BinaryChunk;
+    TArray<FBufferView> BufferViews;
+    TArray<FString>     Accessors;
+    TArray<FString>     Images;
+    TArray<FString>     Textures;
+    TArray<FString>     Materials;
+    TArray<FString>     Primitives;
+};
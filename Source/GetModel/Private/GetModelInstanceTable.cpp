@@ -0,0 +1,117 @@
+// Copyright 1998-2019 Epic Games, Inc. All Rights Reserved.
+
+#include "GetModelInstanceTable.h"
+
+#include "Async/ParallelFor.h"
+#include "GetModelAsyncFileWriter.h"
+#include "GetModelVertexTransform.h"
+#include "Misc/Paths.h"
+
+namespace
+{
+const int32 MaxRowChars = GetModelObj::MaxUIntChars + 10 * (GetModelObj::MaxFloatChars + 1) + 2;
+
+char* WriteFloats(char* Out, const float* Values, int32 Count, int32 Precision)
+{
+    for (int32 i = 0; i < Count; i++) {
+        *Out++ = ',';
+        Out    = GetModelObj::WriteFloat(Out, Values[i], Precision);
+    }
+    return Out;
+}
+}  // namespace
+
+FString GetInstanceTablePath(const FString& MeshPath)
+{
+    return FPaths::GetPath(MeshPath) / FPaths::GetBaseFilename(MeshPath) + TEXT("_Instances.csv");
+}
+
+bool WriteInstanceTable(const TArray<FMatrix>& Transforms, const FString& Path, int32 FloatPrecision)
+{
+    FGetModelAsyncFileWriter TableFile(Path);
+    if (!TableFile.IsOpen()) {
+        return false;
+    }
+
+    {
+        FGetModelObjWriter TableWriter(&TableFile, FloatPrecision);
+        const int32        Precision = TableWriter.GetPrecision();
+        TableWriter.AppendString(TEXT("Index,TX,TY,TZ,QX,QY,QZ,QW,SX,SY,SZ\r\n"));
+
+        TableWriter.ParallelAppend(Transforms.Num(), [&Transforms, Precision](FGetModelObjBuffer& Buffer, int32 Begin, int32 End) {
+            for (int32 i = Begin; i < End; i++) {
+                // FTransform splits a mirroring matrix into a negative scale.
+                const FTransform Transform(Transforms[i]);
+                const FVector    Translation = Transform.GetTranslation();
+                const FQuat      Rotation    = Transform.GetRotation();
+                const FVector    Scale       = Transform.GetScale3D();
+
+                char* Out = Buffer.Reserve(MaxRowChars);
+                Out       = GetModelObj::WriteUInt(Out, i);
+                Out       = WriteFloats(Out, &Translation.X, 3, Precision);
+                Out       = WriteFloats(Out, &Rotation.X, 4, Precision);
+                Out       = WriteFloats(Out, &Scale.X, 3, Precision);
+                *Out++    = '\r';
+                *Out++    = '\n';
+                Buffer.Commit(Out);
+            }
+        });
+    }
+
+    return TableFile.Close();
+}
+
+bool CanExpandMeshInstances(int32 NumVertices, int32 NumTriangles, int32 NumCopies)
+{
+    return (int64)NumVertices * NumCopies <= MAX_int32 && (int64)NumTriangles * 3 * NumCopies <= MAX_int32;
+}
+
+bool ExpandMeshInstances(FGetModelMeshSnapshot& Mesh, const TArray<FMatrix>& Transforms)
+{
+    const int32 NumVertices  = Mesh.Positions.Num();
+    const int32 NumTriangles = Mesh.Indices.Num() / 3;
+    const int32 NumCopies    = Transforms.Num();
+    if (!CanExpandMeshInstances(NumVertices, NumTriangles, NumCopies)) {
+        return false;
+    }
+
+    FGetModelMeshSnapshot Expanded;
+    Mesh.Normals.SetNumZeroed(NumVertices);
+    Mesh.UVs.SetNumZeroed(NumVertices);
+    Expanded.Positions.SetNumUninitialized(NumVertices * NumCopies);
+    Expanded.Normals.SetNumUninitialized(NumVertices * NumCopies);
+    TransformVertexCopies(Transforms, Mesh.Positions.GetData(), Mesh.Normals.GetData(), NumVertices, Expanded.Positions.GetData(), Expanded.Normals.GetData());
+
+    // Triangle ranges between usemtl lines; every copy of a range goes before the next range.
+    TArray<int32> RangeStarts = {0};
+    for (int32 Triangle : Mesh.MaterialTriangles) {
+        RangeStarts.Add(FMath::Clamp(Triangle, RangeStarts.Last(), NumTriangles));
+    }
+    RangeStarts.Add(NumTriangles);
+
+    Expanded.UVs.SetNumUninitialized(NumVertices * NumCopies);
+    Expanded.Indices.SetNumUninitialized(NumTriangles * 3 * NumCopies);
+    ParallelFor(NumCopies, [&](int32 Copy) {
+        FMemory::Memcpy(Expanded.UVs.GetData() + Copy * NumVertices, Mesh.UVs.GetData(), NumVertices * sizeof(FVector2D));
+
+        const uint32 BaseVertex = Copy * NumVertices;
+        const bool   bMirrored  = Transforms[Copy].Determinant() < 0.0f;
+        for (int32 Range = 0; Range + 1 < RangeStarts.Num(); Range++) {
+            const int32 RangeTriangles = RangeStarts[Range + 1] - RangeStarts[Range];
+            uint32*     Out            = Expanded.Indices.GetData() + (RangeStarts[Range] * NumCopies + Copy * RangeTriangles) * 3;
+            for (int32 i = RangeStarts[Range] * 3; i < RangeStarts[Range + 1] * 3; i += 3) {
+                *Out++ = Mesh.Indices[i] + BaseVertex;
+                *Out++ = Mesh.Indices[i + (bMirrored ? 2 : 1)] + BaseVertex;
+                *Out++ = Mesh.Indices[i + (bMirrored ? 1 : 2)] + BaseVertex;
+            }
+        }
+    });
+
+    for (int32 Material = 0; Material < Mesh.MaterialTriangles.Num(); Material++) {
+        Expanded.MaterialTriangles.Add(RangeStarts[Material + 1] * NumCopies);
+    }
+    Expanded.MaterialNames = MoveTemp(Mesh.MaterialNames);
+
+    Mesh = MoveTemp(Expanded);
+    return true;
+}
@@ -0,0 +1,35 @@
+// Copyright 1998-2019 Epic Games, Inc. All Rights Reserved.
+
+#pragma once
+
+#include "CoreMinimal.h"
+#include "GetModelObjWriter.h"
+
+/** Instances of one exported mesh, written as a transform table next to it or expanded into it. */
+struct FGetModelInstanceSettings
+{
+    /** Obj space transform of each instance; the mesh itself is written once in its own space. */
+    TArray<FMatrix> Transforms;
+
+    /** Write one copy of the mesh per instance into the mesh file instead of the table. */
+    bool bExpand = false;
+};
+
+/** <mesh file without extension>_Instances.csv */
+FString GetInstanceTablePath(const FString& MeshPath);
+
+/**
+ * Writes Transforms as csv, one instance per row: index, translation, rotation quaternion (x, y, z, w) and scale,
+ * in obj space like the mesh. Safe to call from any thread.
+ */
+bool WriteInstanceTable(const TArray<FMatrix>& Transforms, const FString& Path, int32 FloatPrecision);
+
+/** Whether NumCopies copies of a mesh this size fit the 32 bit indices ExpandMeshInstances writes. */
+bool CanExpandMeshInstances(int32 NumVertices, int32 NumTriangles, int32 NumCopies);
+
+/**
+ * Replaces Mesh with one copy per transform, moved in parallel. Each material's triangles stay together across the
+ * copies, so there are as many usemtl lines as before. Returns false and leaves Mesh alone when the copies would not
+ * fit 32 bit indices.
+ */
+bool ExpandMeshInstances(FGetModelMeshSnapshot& Mesh, const TArray<FMatrix>& Transforms);
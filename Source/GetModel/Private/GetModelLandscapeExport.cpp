@@ -0,0 +1,252 @@
+// Copyright 1998-2019 Epic Games, Inc. All Rights Reserved.
+
+#include "GetModelLandscapeExport.h"
+
+#include "GetModel.h"
+#include "GetModelAsyncFileWriter.h"
+#include "GetModelExportJob.h"
+#include "GetModelObjWriter.h"
+#include "GetModelVertexTransform.h"
+#include "LandscapeComponent.h"
+#include "LandscapeDataAccess.h"
+#include "LandscapeInfo.h"
+#include "LandscapeLayerInfoObject.h"
+#include "LandscapeProxy.h"
+#include "Misc/Paths.h"
+#include "ProfilingDebugging/ScopedTimers.h"
+
+DECLARE_CYCLE_STAT(TEXT("Lock Landscape"), STAT_GetModel_LockLandscape, STATGROUP_GetModel);
+DECLARE_CYCLE_STAT(TEXT("Write Landscape"), STAT_GetModel_WriteLandscape, STATGROUP_GetModel);
+
+namespace
+{
+/** One component of a wave, read on the game thread. */
+struct FLandscapePatchSource
+{
+    TUniquePtr<FLandscapeComponentDataInterface> DataInterface;
+    FMatrix                                      ComponentToObj;
+    FIntPoint                                    SectionBase;
+    uint32                                       BaseVertex;
+};
+
+/** Where the patches of one landscape go: vertices per side, and the quads of the whole landscape the uvs span. */
+struct FLandscapeGrid
+{
+    int32     SizeVerts;
+    float     QuadsPerVertex;
+    FIntPoint Min;
+    FVector2D UVScale;
+};
+
+/**
+ * Samples one component into Patch, indices already offset by its first vertex in the file. Only reads the mips its
+ * data interface locked, so patches are built on any thread while the game thread holds the locks.
+ */
+void BuildPatch(const FLandscapePatchSource& Source, const FLandscapeGrid& Grid, FGetModelMeshSnapshot& Patch)
+{
+    const int32 NumVertices = Grid.SizeVerts * Grid.SizeVerts;
+    Patch.Positions.SetNumUninitialized(NumVertices);
+    Patch.Normals.SetNumUninitialized(NumVertices);
+    Patch.UVs.SetNumUninitialized(NumVertices);
+    for (int32 Y = 0; Y < Grid.SizeVerts; Y++) {
+        for (int32 X = 0; X < Grid.SizeVerts; X++) {
+            const int32 Vertex = Y * Grid.SizeVerts + X;
+            FVector     TangentX;
+            FVector     TangentY;
+            Patch.Positions[Vertex] = Source.DataInterface->GetLocalVertex(X, Y);
+            Source.DataInterface->GetLocalTangentVectors(X, Y, TangentX, TangentY, Patch.Normals[Vertex]);
+
+            // Invert the y-coordinate like the merged meshes do.
+            const FVector2D Quad = FVector2D(Source.SectionBase - Grid.Min) + FVector2D(X, Y) * Grid.QuadsPerVertex;
+            Patch.UVs[Vertex]    = FVector2D(Quad.X * Grid.UVScale.X, 1.0f - Quad.Y * Grid.UVScale.Y);
+        }
+    }
+    TransformVertices(Source.ComponentToObj, Patch.Positions.GetData(), Patch.Normals.GetData(), NumVertices);
+
+    // Two triangles per quad, wound like the engine's own landscape export.
+    const int32 SizeQuads = Grid.SizeVerts - 1;
+    Patch.Indices.SetNumUninitialized(SizeQuads * SizeQuads * 6);
+    uint32* Out = Patch.Indices.GetData();
+    for (int32 Y = 0; Y < SizeQuads; Y++) {
+        for (int32 X = 0; X < SizeQuads; X++) {
+            const uint32 I00 = Source.BaseVertex + Y * Grid.SizeVerts + X;
+            const uint32 I10 = I00 + 1;
+            const uint32 I01 = I00 + Grid.SizeVerts;
+            const uint32 I11 = I01 + 1;
+            *Out++           = I00;
+            *Out++           = I11;
+            *Out++           = I10;
+            *Out++           = I00;
+            *Out++           = I01;
+            *Out++           = I11;
+        }
+    }
+}
+
+void AppendPatch(FGetModelObjBuffer& Buffer, const FGetModelMeshSnapshot& Patch)
+{
+    GetModelObj::FMeshView View;
+    View.Positions    = (const float*)Patch.Positions.GetData();
+    View.NumPositions = Patch.Positions.Num();
+    View.UVs          = (const float*)Patch.UVs.GetData();
+    View.NumUVs       = Patch.UVs.Num();
+    View.Normals      = (const float*)Patch.Normals.GetData();
+    View.NumNormals   = Patch.Normals.Num();
+    View.Indices      = Patch.Indices.GetData();
+    View.NumIndices   = Patch.Indices.Num();
+
+    GetModelObj::AppendPositions(Buffer, View, 0, View.NumPositions, Buffer.GetPrecision());
+    GetModelObj::AppendTexCoords(Buffer, View, 0, View.NumUVs, Buffer.GetPrecision());
+    GetModelObj::AppendNormals(Buffer, View, 0, View.NumNormals, Buffer.GetPrecision());
+    GetModelObj::AppendFaces(Buffer, View, 0, View.NumIndices / 3);
+}
+}  // namespace
+
+bool ExportLandscape(ALandscapeProxy* Landscape, const FString& ObjPath, const FGetModelLandscapeSettings& Settings, FGetModelExportStats& OutStats)
+{
+    check(IsInGameThread());
+
+    TArray<ULandscapeComponent*> Components;
+    for (ULandscapeComponent* Component : Landscape->LandscapeComponents) {
+        if (Component) {
+            Components.Add(Component);
+        }
+    }
+    if (Components.Num() == 0) {
+        return false;
+    }
+
+    // Every component of a landscape has the same size; the LOD is clamped so one keeps at least a quad.
+    const int32 ComponentSizeQuads = Components[0]->ComponentSizeQuads;
+    const int32 LOD                = FMath::Clamp(Settings.LOD, 0, FMath::FloorLog2(ComponentSizeQuads + 1) - 1);
+
+    FLandscapeGrid Grid;
+    Grid.SizeVerts      = (ComponentSizeQuads + 1) >> LOD;
+    Grid.QuadsPerVertex = (float)ComponentSizeQuads / (Grid.SizeVerts - 1);
+    Grid.Min            = Components[0]->GetSectionBase();
+    FIntPoint Max       = Grid.Min;
+    for (ULandscapeComponent* Component : Components) {
+        Grid.Min = Grid.Min.ComponentMin(Component->GetSectionBase());
+        Max      = Max.ComponentMax(Component->GetSectionBase() + FIntPoint(ComponentSizeQuads, ComponentSizeQuads));
+    }
+    Grid.UVScale = FVector2D(1.0f / (Max.X - Grid.Min.X), 1.0f / (Max.Y - Grid.Min.Y));
+
+    // Row order, so neighbouring patches are next to each other in the file.
+    Components.Sort([](const ULandscapeComponent& A, const ULandscapeComponent& B) {
+        return A.GetSectionBase().Y != B.GetSectionBase().Y ? A.GetSectionBase().Y < B.GetSectionBase().Y : A.GetSectionBase().X < B.GetSectionBase().X;
+    });
+
+    UMaterialInterface* Material     = Landscape->GetLandscapeMaterial();
+    const FString       MaterialName = Material ? Material->GetName() : FString(TEXT("DefaultMaterial"));
+    const FString       MtlPath      = FPaths::ChangeExtension(ObjPath, TEXT("mtl"));
+    const FString       MapsPath     = FPaths::GetPath(ObjPath) / TEXT("maps/");
+    ULandscapeInfo*     Info         = Landscape->GetLandscapeInfo();
+
+    FGetModelAsyncFileWriter ObjFile(ObjPath);
+    if (!ObjFile.IsOpen()) {
+        return false;
+    }
+    bool bWritten = true;
+
+    {
+        FGetModelObjWriter ObjWriter(&ObjFile, Settings.FloatPrecision);
+        GetModelObj::AppendHeader(ObjWriter, StringCast<ANSICHAR>(*FPaths::GetCleanFilename(MtlPath)).Get());
+        ObjWriter.AppendString(TEXT("usemtl ") + MaterialName + TEXT("\n"));
+
+        const int32 WaveSize = FMath::Max(Settings.ComponentsPerWave, 1);
+        for (int32 WaveStart = 0; WaveStart < Components.Num(); WaveStart += WaveSize) {
+            const int32 WaveCount = FMath::Min(WaveSize, Components.Num() - WaveStart);
+
+            // Heightmaps and weightmaps are shared between components and locked through the engine, so the locks
+            // are taken here and only released once the wave is written.
+            TArray<FLandscapePatchSource> Sources;
+            FGetModelMapExport            Weightmaps;
+            {
+                SCOPE_CYCLE_COUNTER(STAT_GetModel_LockLandscape);
+                FScopedDurationTimer Timer(OutStats.SnapshotSeconds);
+                Sources.SetNum(WaveCount);
+                for (int32 Index = 0; Index < WaveCount; Index++) {
+                    ULandscapeComponent*   Component = Components[WaveStart + Index];
+                    FLandscapePatchSource& Source    = Sources[Index];
+                    Source.DataInterface             = MakeUnique<FLandscapeComponentDataInterface>(Component, LOD);
+                    Source.ComponentToObj            = Component->GetComponentTransform().ToMatrixWithScale() * GetObjSpaceSwizzle();
+                    Source.SectionBase               = Component->GetSectionBase();
+                    Source.BaseVertex                = (WaveStart + Index) * Grid.SizeVerts * Grid.SizeVerts;
+
+                    if (!Settings.bWeightmaps || !Info) {
+                        continue;
+                    }
+                    for (const FLandscapeInfoLayerSettings& Layer : Info->Layers) {
+                        TArray<uint8> Weights;
+                        if (!Layer.LayerInfoObj || !Source.DataInterface->GetWeightmapTextureData(Layer.LayerInfoObj, Weights)) {
+                            continue;
+                        }
+
+                        // With several subsections the weightmap repeats their shared edge texels, so it is larger than
+                        // the vertex grid; each vertex reads its texel through its subsection like the heightmap does.
+                        const int32    WeightmapSize = FMath::RoundToInt(FMath::Sqrt((float)Weights.Num()));
+                        TArray<FColor> Pixels;
+                        Pixels.SetNumUninitialized(Grid.SizeVerts * Grid.SizeVerts);
+                        bool bMatches = WeightmapSize * WeightmapSize == Weights.Num();
+                        for (int32 Y = 0; Y < Grid.SizeVerts && bMatches; Y++) {
+                            for (int32 X = 0; X < Grid.SizeVerts && bMatches; X++) {
+                                int32 TexelX = 0;
+                                int32 TexelY = 0;
+                                Source.DataInterface->VertexXYToTexelXY(X, Y, TexelX, TexelY);
+                                bMatches = TexelX < WeightmapSize && TexelY < WeightmapSize;
+                                if (bMatches) {
+                                    const uint8 Weight             = Weights[TexelY * WeightmapSize + TexelX];
+                                    Pixels[Y * Grid.SizeVerts + X] = FColor(Weight, Weight, Weight, 255);
+                                }
+                            }
+                        }
+                        if (!bMatches) {
+                            UE_LOG(LogGetModel, Warning, TEXT("%s: %d weights of layer %s do not cover the %dx%d vertices of component %d,%d, skipped"), *Landscape->GetName(), Weights.Num(), *Layer.GetLayerName().ToString(), Grid.SizeVerts, Grid.SizeVerts, Source.SectionBase.X, Source.SectionBase.Y);
+                            continue;
+                        }
+
+                        FGetModelTextureSnapshot& Snapshot = Weightmaps.Snapshots[Weightmaps.Snapshots.AddDefaulted()];
+                        Snapshot.Name                      = FString::Printf(TEXT("%s_%s_%d_%d"), *Landscape->GetName(), *Layer.GetLayerName().ToString(), Source.SectionBase.X, Source.SectionBase.Y);
+                        Snapshot.SizeX                     = Grid.SizeVerts;
+                        Snapshot.SizeY                     = Grid.SizeVerts;
+                        Snapshot.Pixels                    = MoveTemp(Pixels);
+                        Weightmaps.Formats.Add(Settings.WeightmapFormat);
+                        Weightmaps.Filenames.Add(MapsPath + Snapshot.Name + TEXT(".") + GetTextureFormatExtension(Settings.WeightmapFormat));
+                        OutStats.TextureSizes.Add(FIntPoint(Grid.SizeVerts, Grid.SizeVerts));
+                        OutStats.Files.Add(Weightmaps.Filenames.Last());
+                    }
+                }
+            }
+
+            // One patch per range: built, formatted and dropped on a worker, written in component order.
+            {
+                SCOPE_CYCLE_COUNTER(STAT_GetModel_WriteLandscape);
+                FScopedDurationTimer Timer(OutStats.WriteMeshSeconds);
+                ObjWriter.ParallelAppend(WaveCount, [&Sources, &Grid](FGetModelObjBuffer& Buffer, int32 Begin, int32 End) {
+                    for (int32 Index = Begin; Index < End; Index++) {
+                        FGetModelMeshSnapshot Patch;
+                        BuildPatch(Sources[Index], Grid, Patch);
+                        AppendPatch(Buffer, Patch);
+                    }
+                }, 1);
+            }
+            {
+                FScopedDurationTimer Timer(OutStats.WriteMapsSeconds);
+                bWritten &= WriteMaterialMaps(Weightmaps);
+            }
+        }
+
+        GetModelObj::AppendFooter(ObjWriter);
+    }
+
+    {
+        FScopedDurationTimer Timer(OutStats.WriteMtlSeconds);
+        bWritten &= WriteMtlFile(MtlPath, {MaterialName}, TMap<FString, FString>());
+    }
+
+    OutStats.Vertices  = Components.Num() * Grid.SizeVerts * Grid.SizeVerts;
+    OutStats.Triangles = Components.Num() * (Grid.SizeVerts - 1) * (Grid.SizeVerts - 1) * 2;
+    OutStats.Files.Insert(ObjPath, 0);
+    OutStats.Files.Insert(MtlPath, 1);
+    return ObjFile.Close() && bWritten;
+}
@@ -0,0 +1,35 @@
+// Copyright 1998-2019 Epic Games, Inc. All Rights Reserved.
+
+#pragma once
+
+#include "CoreMinimal.h"
+#include "GetModelExportReport.h"
+#include "GetModelTextureEncoder.h"
+
+class ALandscapeProxy;
+
+/** How ExportLandscape samples and writes a landscape. */
+struct FGetModelLandscapeSettings
+{
+    /** Landscape LOD the heights are sampled at, each one halving the vertices along a side. */
+    int32 LOD            = 0;
+    int32 FloatPrecision = 6;
+
+    /** Components sampled and generated together; bounds the memory held at once. */
+    int32 ComponentsPerWave = 64;
+
+    /**
+     * Also write each paint layer's weights as one grayscale tile per component, into maps/ next to the obj as
+     * <Landscape>_<Layer>_<SectionX>_<SectionY>.<ext>. The obj uvs span the whole landscape.
+     */
+    bool                   bWeightmaps     = false;
+    EGetModelTextureFormat WeightmapFormat = EGetModelTextureFormat::PNG;
+};
+
+/**
+ * Writes every component of Landscape into the obj at ObjPath and a mtl naming its material, in world and obj space
+ * like the merged meshes. Components are locked a wave at a time on the game thread, their vertices and triangles
+ * generated in parallel and streamed to the file before the next wave, so memory does not grow with the landscape.
+ * Game thread only.
+ */
+bool ExportLandscape(ALandscapeProxy* Landscape, const FString& ObjPath, const FGetModelLandscapeSettings& Settings, FGetModelExportStats& OutStats);
@@ -0,0 +1,210 @@
+// Copyright 1998-2019 Epic Games, Inc. All Rights Reserved.
+
+#include "GetModelMeshCodec.h"
+
+#include <algorithm>
+#include <cstring>
+
+namespace GetModelCodec
+{
+namespace
+{
+const size_t BlockVertices = 256;
+const size_t GroupSize     = 16;
+
+/** Bits per byte for each 2 bit group header. */
+const int32_t GroupBits[4] = {0, 2, 4, 8};
+
+size_t GetNumGroups(size_t Count)
+{
+    return (Count + GroupSize - 1) / GroupSize;
+}
+
+uint8_t ZigZag8(uint8_t Delta)
+{
+    return (uint8_t)((Delta << 1) ^ (uint8_t)((int8_t)Delta >> 7));
+}
+
+uint8_t UnZigZag8(uint8_t Value)
+{
+    return (uint8_t)((Value >> 1) ^ (uint8_t)(-(int32_t)(Value & 1)));
+}
+
+/** Headers for every group of Plane, then the packed groups. */
+uint8_t* EncodePlane(uint8_t* Out, const uint8_t* Plane, size_t Count)
+{
+    const size_t NumGroups = GetNumGroups(Count);
+    uint8_t*     Headers   = Out;
+    Out += (NumGroups + 3) / 4;
+    std::memset(Headers, 0, (NumGroups + 3) / 4);
+
+    for (size_t Group = 0; Group < NumGroups; Group++) {
+        // Padding past Count reads as zero, which every width can hold.
+        uint8_t Values[GroupSize] = {};
+        std::memcpy(Values, Plane + Group * GroupSize, std::min(GroupSize, Count - Group * GroupSize));
+
+        uint8_t Largest = 0;
+        for (uint8_t Value : Values) {
+            Largest = std::max(Largest, Value);
+        }
+        const int32_t Header = Largest == 0 ? 0 : Largest < 4 ? 1 : Largest < 16 ? 2 : 3;
+        const int32_t Bits   = GroupBits[Header];
+        Headers[Group / 4] |= (uint8_t)(Header << (2 * (Group % 4)));
+
+        if (Bits == 8) {
+            std::memcpy(Out, Values, GroupSize);
+            Out += GroupSize;
+        } else if (Bits) {
+            const int32_t PerByte = 8 / Bits;
+            for (size_t i = 0; i < GroupSize; i += PerByte) {
+                uint8_t Packed = 0;
+                for (int32_t j = 0; j < PerByte; j++) {
+                    Packed |= (uint8_t)(Values[i + j] << (j * Bits));
+                }
+                *Out++ = Packed;
+            }
+        }
+    }
+    return Out;
+}
+
+/** Returns the end of the plane in Data, or nullptr when it runs past End. */
+const uint8_t* DecodePlane(uint8_t* Plane, size_t Count, const uint8_t* Data, const uint8_t* End)
+{
+    const size_t   NumGroups = GetNumGroups(Count);
+    const uint8_t* Headers   = Data;
+    if ((size_t)(End - Data) < (NumGroups + 3) / 4) {
+        return nullptr;
+    }
+    Data += (NumGroups + 3) / 4;
+
+    for (size_t Group = 0; Group < NumGroups; Group++) {
+        const int32_t Bits    = GroupBits[(Headers[Group / 4] >> (2 * (Group % 4))) & 3];
+        const size_t  NumData = Bits * GroupSize / 8;
+        if ((size_t)(End - Data) < NumData) {
+            return nullptr;
+        }
+
+        uint8_t Values[GroupSize] = {};
+        if (Bits == 8) {
+            std::memcpy(Values, Data, GroupSize);
+        } else if (Bits) {
+            const int32_t PerByte = 8 / Bits;
+            const uint8_t Mask    = (uint8_t)((1 << Bits) - 1);
+            for (size_t i = 0; i < GroupSize; i++) {
+                Values[i] = (Data[i / PerByte] >> ((i % PerByte) * Bits)) & Mask;
+            }
+        }
+        Data += NumData;
+        std::memcpy(Plane + Group * GroupSize, Values, std::min(GroupSize, Count - Group * GroupSize));
+    }
+    return Data;
+}
+}  // namespace
+
+size_t GetVertexStreamBound(size_t Count, size_t Stride)
+{
+    const size_t NumBlocks = (Count + BlockVertices - 1) / BlockVertices;
+    const size_t NumGroups = GetNumGroups(BlockVertices);
+    return NumBlocks * Stride * ((NumGroups + 3) / 4 + NumGroups * GroupSize);
+}
+
+size_t GetIndexStreamBound(size_t Count)
+{
+    return Count * 5;
+}
+
+size_t EncodeVertexStream(uint8_t* Out, const void* Vertices, size_t Count, size_t Stride)
+{
+    const uint8_t* Bytes = (const uint8_t*)Vertices;
+    uint8_t*       Begin = Out;
+    uint8_t        Previous[MaxVertexStride] = {};
+    uint8_t        Plane[BlockVertices];
+
+    for (size_t BlockStart = 0; BlockStart < Count; BlockStart += BlockVertices) {
+        const size_t BlockCount = std::min(BlockVertices, Count - BlockStart);
+        for (size_t Byte = 0; Byte < Stride; Byte++) {
+            uint8_t Last = Previous[Byte];
+            for (size_t i = 0; i < BlockCount; i++) {
+                const uint8_t Value = Bytes[(BlockStart + i) * Stride + Byte];
+                Plane[i]            = ZigZag8((uint8_t)(Value - Last));
+                Last                = Value;
+            }
+            Previous[Byte] = Last;
+            Out            = EncodePlane(Out, Plane, BlockCount);
+        }
+    }
+    return Out - Begin;
+}
+
+bool DecodeVertexStream(void* Vertices, size_t Count, size_t Stride, const uint8_t* Data, size_t Size)
+{
+    if (Stride == 0 || Stride > MaxVertexStride) {
+        return false;
+    }
+
+    uint8_t*       Bytes                     = (uint8_t*)Vertices;
+    const uint8_t* End                       = Data + Size;
+    uint8_t        Previous[MaxVertexStride] = {};
+    uint8_t        Plane[BlockVertices];
+
+    for (size_t BlockStart = 0; BlockStart < Count; BlockStart += BlockVertices) {
+        const size_t BlockCount = std::min(BlockVertices, Count - BlockStart);
+        for (size_t Byte = 0; Byte < Stride; Byte++) {
+            Data = DecodePlane(Plane, BlockCount, Data, End);
+            if (!Data) {
+                return false;
+            }
+
+            uint8_t Last = Previous[Byte];
+            for (size_t i = 0; i < BlockCount; i++) {
+                Last                                    = (uint8_t)(Last + UnZigZag8(Plane[i]));
+                Bytes[(BlockStart + i) * Stride + Byte] = Last;
+            }
+            Previous[Byte] = Last;
+        }
+    }
+    return Data == End;
+}
+
+size_t EncodeIndexStream(uint8_t* Out, const uint32_t* Indices, size_t Count)
+{
+    uint8_t* Begin    = Out;
+    uint32_t Previous = 0;
+    for (size_t i = 0; i < Count; i++) {
+        const int32_t Delta = (int32_t)(Indices[i] - Previous);
+        uint32_t      Value = ((uint32_t)Delta << 1) ^ (uint32_t)(Delta >> 31);
+        Previous            = Indices[i];
+
+        while (Value >= 0x80) {
+            *Out++ = (uint8_t)(Value | 0x80);
+            Value >>= 7;
+        }
+        *Out++ = (uint8_t)Value;
+    }
+    return Out - Begin;
+}
+
+bool DecodeIndexStream(uint32_t* Indices, size_t Count, const uint8_t* Data, size_t Size)
+{
+    const uint8_t* End      = Data + Size;
+    uint32_t       Previous = 0;
+    for (size_t i = 0; i < Count; i++) {
+        uint32_t Value = 0;
+        for (int32_t Shift = 0;; Shift += 7) {
+            if (Data == End || Shift > 28) {
+                return false;
+            }
+            const uint8_t Byte = *Data++;
+            Value |= (uint32_t)(Byte & 0x7f) << Shift;
+            if (!(Byte & 0x80)) {
+                break;
+            }
+        }
+
+        Previous   = Previous + ((Value >> 1) ^ (uint32_t)(-(int32_t)(Value & 1)));
+        Indices[i] = Previous;
+    }
+    return Data == End;
+}
+}  // namespace GetModelCodec
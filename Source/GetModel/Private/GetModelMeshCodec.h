@@ -0,0 +1,36 @@
+// Copyright 1998-2019 Epic Games, Inc. All Rights Reserved.
+
+#pragma once
+
+// Engine independent like GetModelObjFormat.h, so runtimes can decode with the same code and the codec can be
+// benchmarked and fuzzed natively (see Tools/GetModelObjCore).
+#include <cstddef>
+#include <cstdint>
+
+/**
+ * Byte oriented mesh stream compression, cheap to decode and friendly to a general purpose compressor on top.
+ *
+ * Vertex streams: in blocks of up to 256 vertices, byte k of every vertex is delta coded against byte k of the
+ * previous vertex and zigzagged, giving one byte plane per vertex byte. Each plane is stored in groups of 16 bytes,
+ * with a 2 bit header per group (packed 4 per byte, before the groups of the plane) choosing 0, 2, 4 or 8 bits per byte.
+ * Smooth, locality ordered data mostly lands in the 0 to 4 bit groups.
+ *
+ * Index streams: every index as the zigzagged difference to the previous one, in little endian base 128 varints.
+ * After a vertex fetch reorder most indices take a single byte.
+ */
+namespace GetModelCodec
+{
+const size_t MaxVertexStride = 256;
+
+/** Upper bounds of the encoded sizes, for reserving the output. */
+size_t GetVertexStreamBound(size_t Count, size_t Stride);
+size_t GetIndexStreamBound(size_t Count);
+
+/** Each returns the number of bytes written to Out. Stride must be in [1, MaxVertexStride]. */
+size_t EncodeVertexStream(uint8_t* Out, const void* Vertices, size_t Count, size_t Stride);
+size_t EncodeIndexStream(uint8_t* Out, const uint32_t* Indices, size_t Count);
+
+/** Each returns false when Data does not hold exactly Count elements. */
+bool DecodeVertexStream(void* Vertices, size_t Count, size_t Stride, const uint8_t* Data, size_t Size);
+bool DecodeIndexStream(uint32_t* Indices, size_t Count, const uint8_t* Data, size_t Size);
+}  // namespace GetModelCodec
@@ -0,0 +1,335 @@
+// Copyright 1998-2019 Epic Games, Inc. All Rights Reserved.
+
+#include "GetModelMeshOptimizer.h"
+
+namespace
+{
+// Constants from Tom Forsyth's "Linear-Speed Vertex Cache Optimisation".
+const float CacheDecayPower   = 1.5f;
+const float LastTriangleScore = 0.75f;
+const float ValenceBoostScale = 2.0f;
+const float ValenceBoostPower = 0.5f;
+const int32 MaxCacheSize      = 64;
+const int32 MaxValenceScores  = 32;
+
+/** Vertex scores by cache position and by remaining triangle count, computed once per cache size. */
+class FVertexScores
+{
+public:
+    explicit FVertexScores(int32 InCacheSize)
+        : CacheSize(InCacheSize)
+    {
+        for (int32 Position = 0; Position < CacheSize; Position++) {
+            // The three vertices of the last triangle get a fixed score, so the next pick does not just reuse them.
+            CacheScores[Position] = Position < 3 ? LastTriangleScore : FMath::Pow(1.0f - (float)(Position - 3) / (CacheSize - 3), CacheDecayPower);
+        }
+        for (int32 Valence = 1; Valence < MaxValenceScores; Valence++) {
+            ValenceScores[Valence] = ValenceBoostScale * FMath::Pow((float)Valence, -ValenceBoostPower);
+        }
+    }
+
+    float Get(int32 CachePosition, int32 RemainingTriangles) const
+    {
+        if (RemainingTriangles == 0) {
+            return -1.0f;
+        }
+
+        // Low valence vertices are boosted, so lone triangles get picked before they become expensive leftovers.
+        const float ValenceScore = RemainingTriangles < MaxValenceScores ? ValenceScores[RemainingTriangles] : ValenceBoostScale * FMath::Pow((float)RemainingTriangles, -ValenceBoostPower);
+        return (CachePosition >= 0 ? CacheScores[CachePosition] : 0.0f) + ValenceScore;
+    }
+
+    const int32 CacheSize;
+
+private:
+    float CacheScores[MaxCacheSize];
+    float ValenceScores[MaxValenceScores];
+};
+
+/** Triangles of one material range, their vertices renumbered from 0 so every array below is range sized. */
+struct FRangeMesh
+{
+    TArray<uint32> Indices;
+    TArray<uint32> LocalToGlobal;
+
+    FRangeMesh(TArrayView<const uint32> GlobalIndices, TArray<int32>& GlobalToLocal)
+    {
+        Indices.SetNumUninitialized(GlobalIndices.Num());
+        for (int32 i = 0; i < GlobalIndices.Num(); i++) {
+            int32& Local = GlobalToLocal[GlobalIndices[i]];
+            if (Local == INDEX_NONE) {
+                Local = LocalToGlobal.Add(GlobalIndices[i]);
+            }
+            Indices[i] = Local;
+        }
+
+        // Leave the shared map clean for the next range.
+        for (uint32 Global : LocalToGlobal) {
+            GlobalToLocal[Global] = INDEX_NONE;
+        }
+    }
+};
+
+/** Forsyth: greedily emits the best scoring triangle among those using a cached vertex. Indices are range local. */
+void OptimizeVertexCache(TArray<uint32>& Indices, int32 NumVertices, const FVertexScores& Scores)
+{
+    const int32 NumTriangles = Indices.Num() / 3;
+
+    // Triangles using each vertex, the first Remaining[v] of a vertex's slots are the ones not emitted yet.
+    TArray<int32> Remaining;
+    TArray<int32> Offsets;
+    TArray<int32> Adjacency;
+    Remaining.SetNumZeroed(NumVertices);
+    Offsets.SetNumUninitialized(NumVertices + 1);
+    Adjacency.SetNumUninitialized(Indices.Num());
+    for (uint32 Index : Indices) {
+        Remaining[Index]++;
+    }
+    Offsets[0] = 0;
+    for (int32 Vertex = 0; Vertex < NumVertices; Vertex++) {
+        Offsets[Vertex + 1] = Offsets[Vertex] + Remaining[Vertex];
+        Remaining[Vertex]   = 0;
+    }
+    for (int32 i = 0; i < Indices.Num(); i++) {
+        Adjacency[Offsets[Indices[i]] + Remaining[Indices[i]]++] = i / 3;
+    }
+
+    TArray<int32> CachePositions;
+    TArray<float> VertexScores;
+    CachePositions.Init(INDEX_NONE, NumVertices);
+    VertexScores.SetNumUninitialized(NumVertices);
+    for (int32 Vertex = 0; Vertex < NumVertices; Vertex++) {
+        VertexScores[Vertex] = Scores.Get(INDEX_NONE, Remaining[Vertex]);
+    }
+
+    TArray<float> TriangleScores;
+    TArray<bool>  Emitted;
+    TriangleScores.SetNumUninitialized(NumTriangles);
+    Emitted.SetNumZeroed(NumTriangles);
+    int32 BestTriangle = INDEX_NONE;
+    float BestScore    = -MAX_FLT;
+    for (int32 Triangle = 0; Triangle < NumTriangles; Triangle++) {
+        TriangleScores[Triangle] = VertexScores[Indices[3 * Triangle]] + VertexScores[Indices[3 * Triangle + 1]] + VertexScores[Indices[3 * Triangle + 2]];
+        if (TriangleScores[Triangle] > BestScore) {
+            BestTriangle = Triangle;
+            BestScore    = TriangleScores[Triangle];
+        }
+    }
+
+    TArray<uint32> Output;
+    TArray<int32>  Cache;
+    TArray<int32>  NewCache;
+    Output.Reserve(Indices.Num());
+    Cache.Reserve(Scores.CacheSize + 3);
+    NewCache.Reserve(Scores.CacheSize + 3);
+    int32 Cursor = 0;
+
+    for (int32 Emit = 0; Emit < NumTriangles; Emit++) {
+        // Nothing in the cache touches a live triangle: continue with the next one in input order.
+        if (BestTriangle == INDEX_NONE) {
+            while (Emitted[Cursor]) {
+                Cursor++;
+            }
+            BestTriangle = Cursor;
+        }
+
+        const uint32* Corners = &Indices[3 * BestTriangle];
+        Output.Append(Corners, 3);
+        Emitted[BestTriangle] = true;
+
+        // A degenerate triangle is listed once per corner it has on a vertex, so every one of its slots goes.
+        NewCache.Reset();
+        for (int32 Corner = 0; Corner < 3; Corner++) {
+            const int32 Vertex = Corners[Corner];
+            if (NewCache.Contains(Vertex)) {
+                continue;
+            }
+            NewCache.Add(Vertex);
+
+            int32* Triangles = &Adjacency[Offsets[Vertex]];
+            for (int32 Slot = 0; Slot < Remaining[Vertex];) {
+                if (Triangles[Slot] == BestTriangle) {
+                    Triangles[Slot] = Triangles[--Remaining[Vertex]];
+                } else {
+                    Slot++;
+                }
+            }
+        }
+        for (int32 Vertex : Cache) {
+            if (!NewCache.Contains(Vertex)) {
+                NewCache.Add(Vertex);
+            }
+        }
+
+        // Rescore every vertex that moved, including the ones pushed out, then the live triangles around them.
+        for (int32 Position = 0; Position < NewCache.Num(); Position++) {
+            const int32 Vertex     = NewCache[Position];
+            CachePositions[Vertex] = Position < Scores.CacheSize ? Position : INDEX_NONE;
+            VertexScores[Vertex]   = Scores.Get(CachePositions[Vertex], Remaining[Vertex]);
+        }
+
+        BestTriangle = INDEX_NONE;
+        BestScore    = -MAX_FLT;
+        for (int32 Vertex : NewCache) {
+            for (int32 Slot = 0; Slot < Remaining[Vertex]; Slot++) {
+                const int32 Triangle = Adjacency[Offsets[Vertex] + Slot];
+                if (Emitted[Triangle]) {
+                    continue;
+                }
+                TriangleScores[Triangle] = VertexScores[Indices[3 * Triangle]] + VertexScores[Indices[3 * Triangle + 1]] + VertexScores[Indices[3 * Triangle + 2]];
+                if (TriangleScores[Triangle] > BestScore) {
+                    BestTriangle = Triangle;
+                    BestScore    = TriangleScores[Triangle];
+                }
+            }
+        }
+
+        Cache.Reset();
+        Cache.Append(NewCache.GetData(), FMath::Min(NewCache.Num(), Scores.CacheSize));
+    }
+
+    Indices = MoveTemp(Output);
+}
+
+/**
+ * Cuts the cache ordered triangles into clusters where the simulated cache starts over, and draws the clusters facing
+ * away from the range's center first: they are the likeliest to cover the rest. Clusters keep their inner order, so
+ * the cache efficiency barely moves.
+ */
+void OptimizeOverdraw(TArray<uint32>& Indices, const TArray<uint32>& LocalToGlobal, const FGetModelMeshSnapshot& Mesh, int32 CacheSize)
+{
+    const int32 NumTriangles = Indices.Num() / 3;
+
+    TArray<int32> ClusterStarts;
+    TArray<int32> CacheStamps;
+    CacheStamps.Init(-CacheSize - 1, LocalToGlobal.Num());
+    int32 Time = 0;
+    for (int32 Triangle = 0; Triangle < NumTriangles; Triangle++) {
+        // A fifo of CacheSize entries; a triangle with all three corners missing starts a cluster.
+        bool bAnyHit = false;
+        for (int32 Corner = 0; Corner < 3; Corner++) {
+            const uint32 Vertex = Indices[3 * Triangle + Corner];
+            if (Time - CacheStamps[Vertex] <= CacheSize) {
+                bAnyHit = true;
+            } else {
+                CacheStamps[Vertex] = ++Time;
+            }
+        }
+        if (!bAnyHit) {
+            ClusterStarts.Add(Triangle);
+        }
+    }
+    if (ClusterStarts.Num() < 2) {
+        return;
+    }
+    ClusterStarts.Add(NumTriangles);
+
+    // Vertex normals decide facing rather than the winding, which the axis swap into obj space mirrors.
+    FVector         MeshCenter = FVector::ZeroVector;
+    TArray<FVector> Centers;
+    TArray<FVector> Normals;
+    for (int32 Cluster = 0; Cluster + 1 < ClusterStarts.Num(); Cluster++) {
+        FVector Center = FVector::ZeroVector;
+        FVector Normal = FVector::ZeroVector;
+        for (int32 i = 3 * ClusterStarts[Cluster]; i < 3 * ClusterStarts[Cluster + 1]; i++) {
+            Center += Mesh.Positions[LocalToGlobal[Indices[i]]];
+            Normal += Mesh.Normals[LocalToGlobal[Indices[i]]];
+        }
+        Center /= 3 * (ClusterStarts[Cluster + 1] - ClusterStarts[Cluster]);
+        MeshCenter += Center * (ClusterStarts[Cluster + 1] - ClusterStarts[Cluster]);
+        Centers.Add(Center);
+        Normals.Add(Normal.GetSafeNormal());
+    }
+    MeshCenter /= NumTriangles;
+
+    TArray<float> Keys;
+    TArray<int32> Order;
+    for (int32 Cluster = 0; Cluster < Centers.Num(); Cluster++) {
+        Keys.Add((Centers[Cluster] - MeshCenter) | Normals[Cluster]);
+        Order.Add(Cluster);
+    }
+    Order.StableSort([&Keys](int32 A, int32 B) { return Keys[A] > Keys[B]; });
+
+    TArray<uint32> Output;
+    Output.Reserve(Indices.Num());
+    for (int32 Cluster : Order) {
+        Output.Append(&Indices[3 * ClusterStarts[Cluster]], 3 * (ClusterStarts[Cluster + 1] - ClusterStarts[Cluster]));
+    }
+    Indices = MoveTemp(Output);
+}
+
+/** Renumbers vertices in the order the triangles first use them; unused ones keep their order at the end. */
+void OptimizeVertexFetch(FGetModelMeshSnapshot& Mesh)
+{
+    const int32 NumVertices = Mesh.Positions.Num();
+
+    TArray<uint32> Remap;
+    Remap.Init(MAX_uint32, NumVertices);
+    uint32 NextVertex = 0;
+    for (uint32& Index : Mesh.Indices) {
+        if (Remap[Index] == MAX_uint32) {
+            Remap[Index] = NextVertex++;
+        }
+        Index = Remap[Index];
+    }
+    for (uint32& Vertex : Remap) {
+        if (Vertex == MAX_uint32) {
+            Vertex = NextVertex++;
+        }
+    }
+
+    TArray<FVector>   Positions;
+    TArray<FVector2D> UVs;
+    TArray<FVector>   Normals;
+    Positions.SetNumUninitialized(NumVertices);
+    UVs.SetNumUninitialized(NumVertices);
+    Normals.SetNumUninitialized(NumVertices);
+    for (int32 Vertex = 0; Vertex < NumVertices; Vertex++) {
+        Positions[Remap[Vertex]] = Mesh.Positions[Vertex];
+        UVs[Remap[Vertex]]       = Mesh.UVs[Vertex];
+        Normals[Remap[Vertex]]   = Mesh.Normals[Vertex];
+    }
+    Mesh.Positions = MoveTemp(Positions);
+    Mesh.UVs       = MoveTemp(UVs);
+    Mesh.Normals   = MoveTemp(Normals);
+}
+}  // namespace
+
+void OptimizeMeshSnapshot(FGetModelMeshSnapshot& Mesh, const FGetModelOptimizeSettings& Settings)
+{
+    const int32 NumTriangles = Mesh.Indices.Num() / 3;
+    if (NumTriangles == 0) {
+        return;
+    }
+
+    const FVertexScores Scores(FMath::Clamp(Settings.CacheSize, 4, MaxCacheSize));
+
+    // Material ranges, including whatever precedes the first usemtl.
+    TArray<int32> RangeStarts;
+    RangeStarts.Add(0);
+    for (int32 Triangle : Mesh.MaterialTriangles) {
+        if (Triangle > RangeStarts.Last()) {
+            RangeStarts.Add(Triangle);
+        }
+    }
+    RangeStarts.Add(NumTriangles);
+
+    TArray<int32> GlobalToLocal;
+    GlobalToLocal.Init(INDEX_NONE, Mesh.Positions.Num());
+    for (int32 Range = 0; Range + 1 < RangeStarts.Num(); Range++) {
+        const int32 FirstIndex = 3 * RangeStarts[Range];
+        const int32 NumIndices = 3 * (RangeStarts[Range + 1] - RangeStarts[Range]);
+
+        FRangeMesh RangeMesh(TArrayView<const uint32>(Mesh.Indices.GetData() + FirstIndex, NumIndices), GlobalToLocal);
+        OptimizeVertexCache(RangeMesh.Indices, RangeMesh.LocalToGlobal.Num(), Scores);
+        if (Settings.bOverdraw) {
+            OptimizeOverdraw(RangeMesh.Indices, RangeMesh.LocalToGlobal, Mesh, Scores.CacheSize);
+        }
+
+        for (int32 i = 0; i < NumIndices; i++) {
+            Mesh.Indices[FirstIndex + i] = RangeMesh.LocalToGlobal[RangeMesh.Indices[i]];
+        }
+    }
+
+    OptimizeVertexFetch(Mesh);
+}
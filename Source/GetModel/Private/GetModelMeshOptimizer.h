@@ -0,0 +1,24 @@
+// Copyright 1998-2019 Epic Games, Inc. All Rights Reserved.
+
+#pragma once
+
+#include "CoreMinimal.h"
+#include "GetModelObjWriter.h"
+
+/** What OptimizeMeshSnapshot does besides the vertex cache order. */
+struct FGetModelOptimizeSettings
+{
+    /** Simulated post-transform cache size, 32 suits current desktop and mobile parts. */
+    int32 CacheSize = 32;
+
+    /** Also sort clusters of triangles so outward facing ones are drawn first. */
+    bool bOverdraw = false;
+};
+
+/**
+ * Reorders the triangles of each material range for the post-transform vertex cache (Forsyth's linear-speed
+ * algorithm), optionally sorts them for overdraw, then renumbers vertices in first-use order so fetches run forward
+ * through memory. Triangles never leave their material range and every attribute moves with its vertex, so the mesh
+ * renders exactly as before.
+ */
+void OptimizeMeshSnapshot(FGetModelMeshSnapshot& Mesh, const FGetModelOptimizeSettings& Settings);
@@ -0,0 +1,409 @@
+// Copyright 1998-2019 Epic Games, Inc. All Rights Reserved.
+
+#include "GetModelObjFormat.h"
+
+#include <cmath>
+#include <cstdio>
+#include <cstdlib>
+
+namespace GetModelObj
+{
+namespace
+{
+const uint64_t Pow10Table[] = {
+    1ull,
+    10ull,
+    100ull,
+    1000ull,
+    10000ull,
+    100000ull,
+    1000000ull,
+    10000000ull,
+    100000000ull,
+    1000000000ull,
+};
+
+// Largest scaled value that still converts to uint64 without losing the fraction (2^53).
+const double MaxExactScaled = 9007199254740992.0;
+
+// Shortest round-trip digits follow Ulf Adams' Ryu ("Ryu: fast float-to-string conversion", PLDI 2018), float only:
+// the interval of decimals that read back to the value is scaled by a power of 5 with 64 bit multiplies, then digits
+// are dropped while both ends still differ. The tables hold 5^-i scaled up to 59 bits and 5^i scaled to 61 bits.
+const int32_t MantissaBits    = 23;
+const int32_t ExponentBias    = 127;
+const int32_t Pow5InvBitCount = 59;
+const int32_t Pow5BitCount    = 61;
+
+const uint64_t Pow5InvSplit[31] = {
+    576460752303423489ull, 461168601842738791ull, 368934881474191033ull, 295147905179352826ull,
+    472236648286964522ull, 377789318629571618ull, 302231454903657294ull, 483570327845851670ull,
+    386856262276681336ull, 309485009821345069ull, 495176015714152110ull, 396140812571321688ull,
+    316912650057057351ull, 507060240091291761ull, 405648192073033409ull, 324518553658426727ull,
+    519229685853482763ull, 415383748682786211ull, 332306998946228969ull, 531691198313966350ull,
+    425352958651173080ull, 340282366920938464ull, 544451787073501542ull, 435561429658801234ull,
+    348449143727040987ull, 557518629963265579ull, 446014903970612463ull, 356811923176489971ull,
+    570899077082383953ull, 456719261665907162ull, 365375409332725730ull,
+};
+
+const uint64_t Pow5Split[48] = {
+    1152921504606846976ull, 1441151880758558720ull, 1801439850948198400ull, 2251799813685248000ull,
+    1407374883553280000ull, 1759218604441600000ull, 2199023255552000000ull, 1374389534720000000ull,
+    1717986918400000000ull, 2147483648000000000ull, 1342177280000000000ull, 1677721600000000000ull,
+    2097152000000000000ull, 1310720000000000000ull, 1638400000000000000ull, 2048000000000000000ull,
+    1280000000000000000ull, 1600000000000000000ull, 2000000000000000000ull, 1250000000000000000ull,
+    1562500000000000000ull, 1953125000000000000ull, 1220703125000000000ull, 1525878906250000000ull,
+    1907348632812500000ull, 1192092895507812500ull, 1490116119384765625ull, 1862645149230957031ull,
+    1164153218269348144ull, 1455191522836685180ull, 1818989403545856475ull, 2273736754432320594ull,
+    1421085471520200371ull, 1776356839400250464ull, 2220446049250313080ull, 1387778780781445675ull,
+    1734723475976807094ull, 2168404344971008868ull, 1355252715606880542ull, 1694065894508600678ull,
+    2117582368135750847ull, 1323488980084844279ull, 1654361225106055349ull, 2067951531382569187ull,
+    1292469707114105741ull, 1615587133892632177ull, 2019483917365790221ull, 1262177448353618888ull,
+};
+
+/** Bits of 5^e, 1 for e = 0. */
+int32_t Pow5Bits(int32_t E)
+{
+    return (int32_t)(((uint32_t)E * 1217359) >> 19) + 1;
+}
+
+/** floor(log10(2^e)) and floor(log10(5^e)). */
+uint32_t Log10Pow2(int32_t E)
+{
+    return ((uint32_t)E * 78913) >> 18;
+}
+
+uint32_t Log10Pow5(int32_t E)
+{
+    return ((uint32_t)E * 732923) >> 20;
+}
+
+bool IsMultipleOfPow5(uint32_t Value, uint32_t Power)
+{
+    uint32_t Count = 0;
+    while (Value % 5 == 0 && Count < Power) {
+        Value /= 5;
+        Count++;
+    }
+    return Count >= Power;
+}
+
+bool IsMultipleOfPow2(uint32_t Value, uint32_t Power)
+{
+    return (Value & ((1u << Power) - 1)) == 0;
+}
+
+/** (M * Factor) >> Shift with a 64 bit Factor, Shift > 32. */
+uint32_t MulShift(uint32_t M, uint64_t Factor, int32_t Shift)
+{
+    const uint64_t Low  = (uint64_t)M * (uint32_t)Factor;
+    const uint64_t High = (uint64_t)M * (uint32_t)(Factor >> 32);
+    return (uint32_t)(((Low >> 32) + High) >> (Shift - 32));
+}
+
+/** Shortest decimal Digits * 10^Exponent that reads back to the finite, non-zero float with these bits. */
+void GetShortestDigits(uint32_t Bits, uint32_t& OutDigits, int32_t& OutExponent)
+{
+    const uint32_t IeeeMantissa = Bits & ((1u << MantissaBits) - 1);
+    const uint32_t IeeeExponent = (Bits >> MantissaBits) & 0xff;
+
+    // Two extra bits, so the halfway points to the neighbours are integers too.
+    const int32_t  E2 = (IeeeExponent ? (int32_t)IeeeExponent : 1) - ExponentBias - MantissaBits - 2;
+    const uint32_t M2 = IeeeExponent ? (1u << MantissaBits) | IeeeMantissa : IeeeMantissa;
+
+    // Round half to even decides whether the interval ends belong to it. The gap below a power of two is half as wide.
+    const bool     bAcceptBounds = (M2 & 1) == 0;
+    const uint32_t MV            = 4 * M2;
+    const uint32_t MP            = 4 * M2 + 2;
+    const uint32_t MMShift       = IeeeMantissa != 0 || IeeeExponent <= 1;
+    const uint32_t MM            = 4 * M2 - 1 - MMShift;
+
+    uint32_t VR;
+    uint32_t VP;
+    uint32_t VM;
+    int32_t  E10;
+    bool     bVMTrailingZeros = false;
+    bool     bVRTrailingZeros = false;
+    uint32_t LastRemovedDigit = 0;
+    if (E2 >= 0) {
+        const uint32_t Q = Log10Pow2(E2);
+        const int32_t  K = Pow5InvBitCount + Pow5Bits(Q) - 1;
+        const int32_t  I = -E2 + (int32_t)Q + K;
+        E10              = (int32_t)Q;
+        VR               = MulShift(MV, Pow5InvSplit[Q], I);
+        VP               = MulShift(MP, Pow5InvSplit[Q], I);
+        VM               = MulShift(MM, Pow5InvSplit[Q], I);
+        if (Q != 0 && (VP - 1) / 10 <= VM / 10) {
+            // The loop below may not run, but rounding still needs the first digit it would have dropped.
+            const int32_t L  = Pow5InvBitCount + Pow5Bits(Q - 1) - 1;
+            LastRemovedDigit = MulShift(MV, Pow5InvSplit[Q - 1], -E2 + (int32_t)Q - 1 + L) % 10;
+        }
+        if (Q <= 9) {
+            // At most one of MP, MV and MM is a multiple of 5.
+            if (MV % 5 == 0) {
+                bVRTrailingZeros = IsMultipleOfPow5(MV, Q);
+            } else if (bAcceptBounds) {
+                bVMTrailingZeros = IsMultipleOfPow5(MM, Q);
+            } else {
+                VP -= IsMultipleOfPow5(MP, Q);
+            }
+        }
+    } else {
+        const uint32_t Q = Log10Pow5(-E2);
+        const int32_t  I = -E2 - (int32_t)Q;
+        const int32_t  K = Pow5Bits(I) - Pow5BitCount;
+        const int32_t  J = (int32_t)Q - K;
+        E10              = (int32_t)Q + E2;
+        VR               = MulShift(MV, Pow5Split[I], J);
+        VP               = MulShift(MP, Pow5Split[I], J);
+        VM               = MulShift(MM, Pow5Split[I], J);
+        if (Q != 0 && (VP - 1) / 10 <= VM / 10) {
+            const int32_t L  = (int32_t)Q - 1 - (Pow5Bits(I + 1) - Pow5BitCount);
+            LastRemovedDigit = MulShift(MV, Pow5Split[I + 1], L) % 10;
+        }
+        if (Q <= 1) {
+            // MV has two trailing zero bits, MP one, MM one only when MMShift is set.
+            bVRTrailingZeros = true;
+            if (bAcceptBounds) {
+                bVMTrailingZeros = MMShift == 1;
+            } else {
+                VP--;
+            }
+        } else if (Q < 31) {
+            bVRTrailingZeros = IsMultipleOfPow2(MV, Q - 1);
+        }
+    }
+
+    int32_t Removed = 0;
+    if (bVMTrailingZeros || bVRTrailingZeros) {
+        // Rare: an interval end or the value itself is exact in decimal, so ties and the bounds need care.
+        while (VP / 10 > VM / 10) {
+            bVMTrailingZeros &= VM % 10 == 0;
+            bVRTrailingZeros &= LastRemovedDigit == 0;
+            LastRemovedDigit = VR % 10;
+            VR /= 10;
+            VP /= 10;
+            VM /= 10;
+            Removed++;
+        }
+        if (bVMTrailingZeros) {
+            while (VM % 10 == 0) {
+                bVRTrailingZeros &= LastRemovedDigit == 0;
+                LastRemovedDigit = VR % 10;
+                VR /= 10;
+                VP /= 10;
+                VM /= 10;
+                Removed++;
+            }
+        }
+        if (bVRTrailingZeros && LastRemovedDigit == 5 && VR % 2 == 0) {
+            // Exactly halfway: round to even.
+            LastRemovedDigit = 4;
+        }
+        OutDigits = VR + ((VR == VM && (!bAcceptBounds || !bVMTrailingZeros)) || LastRemovedDigit >= 5);
+    } else {
+        while (VP / 10 > VM / 10) {
+            LastRemovedDigit = VR % 10;
+            VR /= 10;
+            VP /= 10;
+            VM /= 10;
+            Removed++;
+        }
+        OutDigits = VR + (VR == VM || LastRemovedDigit >= 5);
+    }
+    OutExponent = E10 + Removed;
+}
+
+/** Digits * 10^Exponent laid out like printf "%.*g" with as many significant digits as Digits has. */
+char* WriteShortest(char* Out, uint32_t Digits, int32_t Exponent)
+{
+    char    Text[MaxUIntChars];
+    int32_t Count = 0;
+    do {
+        Text[Count++] = '0' + (Digits % 10);
+        Digits /= 10;
+    } while (Digits);
+
+    // Text holds the digits last first; Scientific is the exponent of the first one.
+    const int32_t Scientific = Exponent + Count - 1;
+    if (Scientific >= -4 && Scientific < Count) {
+        if (Scientific < 0) {
+            *Out++ = '0';
+            *Out++ = '.';
+            for (int32_t i = Scientific + 1; i < 0; i++) {
+                *Out++ = '0';
+            }
+        }
+        for (int32_t i = Count - 1; i >= 0; i--) {
+            *Out++ = Text[i];
+            if (i == Count - 1 - Scientific && i > 0) {
+                *Out++ = '.';
+            }
+        }
+        return Out;
+    }
+
+    *Out++ = Text[Count - 1];
+    if (Count > 1) {
+        *Out++ = '.';
+        for (int32_t i = Count - 2; i >= 0; i--) {
+            *Out++ = Text[i];
+        }
+    }
+    *Out++                 = 'e';
+    *Out++                 = Scientific < 0 ? '-' : '+';
+    const int32_t Absolute = Scientific < 0 ? -Scientific : Scientific;
+    if (Absolute < 10) {
+        *Out++ = '0';
+    }
+    return WriteUInt(Out, (uint32_t)Absolute);
+}
+
+char* WriteTriple(char* Out, const float* Values, int32_t Precision)
+{
+    Out    = WriteFloat(Out, Values[0], Precision);
+    *Out++ = ' ';
+    Out    = WriteFloat(Out, Values[1], Precision);
+    *Out++ = ' ';
+    Out    = WriteFloat(Out, Values[2], Precision);
+    *Out++ = '\r';
+    *Out++ = '\n';
+    return Out;
+}
+}  // namespace
+
+int32_t ClampPrecision(int32_t Precision)
+{
+    return std::min(Precision, MaxPrecision);
+}
+
+char* WriteUInt(char* Out, uint32_t Value)
+{
+    char    Digits[MaxUIntChars];
+    int32_t Count = 0;
+    do {
+        Digits[Count++] = '0' + (Value % 10);
+        Value /= 10;
+    } while (Value);
+
+    for (int32_t i = Count - 1; i >= 0; i--) {
+        *Out++ = Digits[i];
+    }
+    return Out;
+}
+
+char* WriteFloat(char* Out, float Value, int32_t Precision)
+{
+    Precision = ClampPrecision(Precision);
+
+    if (Precision < 0) {
+        // Shortest round-trip, laid out like "%g". Never longer than the first "%.*g" precision that reads back, and
+        // a digit shorter for a few powers of two, whose wider upper gap admits a digit string "%.*g" does not round to.
+        if (!std::isfinite(Value)) {
+            return Out + std::snprintf(Out, MaxFloatChars, "%g", Value);
+        }
+
+        uint32_t Bits;
+        std::memcpy(&Bits, &Value, sizeof(Bits));
+        if (Bits >> 31) {
+            *Out++ = '-';
+        }
+        if ((Bits << 1) == 0) {
+            *Out++ = '0';
+            return Out;
+        }
+
+        uint32_t Digits;
+        int32_t  Exponent;
+        GetShortestDigits(Bits, Digits, Exponent);
+        return WriteShortest(Out, Digits, Exponent);
+    }
+
+    // Every float times 10^9 fits in a double mantissa, so the scaled value is exact and rounding it
+    // half-to-even yields the same digits as the CRT's "%.*f".
+    const double Magnitude = std::fabs((double)Value);
+    const double Scaled    = Magnitude * (double)Pow10Table[Precision];
+    if (!std::isfinite(Value) || Scaled >= MaxExactScaled) {
+        return Out + std::snprintf(Out, MaxFloatChars, "%.*f", Precision, Value);
+    }
+
+    uint64_t     Fixed    = (uint64_t)Scaled;
+    const double Fraction = Scaled - (double)Fixed;
+    if (Fraction > 0.5 || (Fraction == 0.5 && (Fixed & 1))) {
+        Fixed++;
+    }
+
+    // Sign bit test, so -0.0 keeps its sign like printf does.
+    if (std::signbit(Value)) {
+        *Out++ = '-';
+    }
+
+    const uint64_t Whole = Fixed / Pow10Table[Precision];
+    uint64_t       Frac  = Fixed % Pow10Table[Precision];
+
+    // Whole part never exceeds 2^53, so 20 digits are plenty.
+    char     Digits[20];
+    int32_t  Count = 0;
+    uint64_t Rest  = Whole;
+    do {
+        Digits[Count++] = '0' + (Rest % 10);
+        Rest /= 10;
+    } while (Rest);
+
+    for (int32_t i = Count - 1; i >= 0; i--) {
+        *Out++ = Digits[i];
+    }
+    if (Precision > 0) {
+        *Out = '.';
+        for (int32_t i = Precision; i > 0; i--) {
+            Out[i] = '0' + (Frac % 10);
+            Frac /= 10;
+        }
+        Out += Precision + 1;
+    }
+    return Out;
+}
+
+char* WriteVertex(char* Out, const float* Xyz, int32_t Precision)
+{
+    *Out++ = 'v';
+    *Out++ = ' ';
+    return WriteTriple(Out, Xyz, Precision);
+}
+
+char* WriteTexCoord(char* Out, const float* Uv, int32_t Precision)
+{
+    *Out++ = 'v';
+    *Out++ = 't';
+    *Out++ = ' ';
+    Out    = WriteFloat(Out, Uv[0], Precision);
+    *Out++ = ' ';
+    Out    = WriteFloat(Out, Uv[1], Precision);
+    *Out++ = '\r';
+    *Out++ = '\n';
+    return Out;
+}
+
+char* WriteNormal(char* Out, const float* Xyz, int32_t Precision)
+{
+    *Out++ = 'v';
+    *Out++ = 'n';
+    *Out++ = ' ';
+    return WriteTriple(Out, Xyz, Precision);
+}
+
+char* WriteFace(char* Out, const uint32_t* Positions, const uint32_t* TexCoords, const uint32_t* Normals)
+{
+    *Out++ = 'f';
+    for (int32_t Corner = 0; Corner < 3; Corner++) {
+        *Out++ = ' ';
+        Out    = WriteUInt(Out, Positions[Corner]);
+        *Out++ = '/';
+        Out    = WriteUInt(Out, TexCoords[Corner]);
+        *Out++ = '/';
+        Out    = WriteUInt(Out, Normals[Corner]);
+    }
+    *Out++ = '\r';
+    *Out++ = '\n';
+    return Out;
+}
+}  // namespace GetModelObj
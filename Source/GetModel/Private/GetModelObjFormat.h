@@ -0,0 +1,162 @@
+// Copyright 1998-2019 Epic Games, Inc. All Rights Reserved.
+
+#pragma once
+
+// Engine independent on purpose: this header and GetModelObjFormat.cpp only use the C++ standard library, so the obj
+// formatting can be built, benchmarked and fuzzed outside the editor (see Tools/GetModelObjCore).
+#include <algorithm>
+#include <cstddef>
+#include <cstdint>
+#include <cstring>
+
+namespace GetModelObj
+{
+/** Fixed precisions above this are clamped, a negative precision writes the shortest round-trip text. */
+const int32_t MaxPrecision = 9;
+
+/** Upper bounds of the characters one call below writes, so callers can reserve before formatting. */
+const int32_t MaxFloatChars    = 64;
+const int32_t MaxUIntChars     = 10;
+const int32_t MaxVertexChars   = 3 + 3 * (MaxFloatChars + 1) + 2;
+const int32_t MaxTexCoordChars = 3 + 2 * (MaxFloatChars + 1) + 2;
+const int32_t MaxFaceChars     = 1 + 3 * (1 + 3 * MaxUIntChars + 2) + 2;
+
+int32_t ClampPrecision(int32_t Precision);
+
+/** Each writes at Out and returns the end of what it wrote, nothing is null terminated. */
+char* WriteUInt(char* Out, uint32_t Value);
+
+/**
+ * Precision >= 0 gives the same digits as printf "%.*f". A negative precision gives the fewest significant digits that
+ * read back to the same float, laid out like printf "%g", at about the speed of the fixed path.
+ */
+char* WriteFloat(char* Out, float Value, int32_t Precision);
+
+/** "v x y z", "vt u v", "vn x y z" and "f p/t/n p/t/n p/t/n", each terminated with \r\n. Face indices are written as given. */
+char* WriteVertex(char* Out, const float* Xyz, int32_t Precision);
+char* WriteTexCoord(char* Out, const float* Uv, int32_t Precision);
+char* WriteNormal(char* Out, const float* Xyz, int32_t Precision);
+char* WriteFace(char* Out, const uint32_t* Positions, const uint32_t* TexCoords, const uint32_t* Normals);
+
+/**
+ * A mesh already in obj space as plain arrays: 3 floats per position and normal, 2 per uv, 3 indices per triangle.
+ * Without remaps an index addresses all three attributes; with them (welded output) each attribute goes through its own.
+ */
+struct FMeshView
+{
+    const float* Positions    = nullptr;
+    int32_t      NumPositions = 0;
+    const float* UVs          = nullptr;
+    int32_t      NumUVs       = 0;
+    const float* Normals      = nullptr;
+    int32_t      NumNormals   = 0;
+
+    const uint32_t* Indices    = nullptr;
+    int32_t         NumIndices = 0;
+
+    const uint32_t* PositionRemap = nullptr;
+    const uint32_t* UVRemap       = nullptr;
+    const uint32_t* NormalRemap   = nullptr;
+
+    /** Ascending triangle at which each usemtl line goes and the name it switches to. */
+    const int32_t*     MaterialTriangles = nullptr;
+    const char* const* MaterialNames     = nullptr;
+    int32_t            NumMaterials      = 0;
+};
+
+/*
+ * The Append functions format into any buffer with
+ *     char* Reserve(int32_t MaxChars);   // room for at least MaxChars at the returned pointer
+ *     void  Commit(char* End);           // keeps what was written up to End
+ * Ranges are [Begin, End) of the attribute or triangle; formatting a block range by range gives the same text as
+ * formatting it in one go, which is what lets the plugin split blocks over worker threads.
+ */
+template <typename BufferType>
+void AppendText(BufferType& Buffer, const char* Text, size_t Length)
+{
+    char* Out = Buffer.Reserve((int32_t)Length);
+    std::copy(Text, Text + Length, Out);
+    Buffer.Commit(Out + Length);
+}
+
+template <typename BufferType>
+void AppendPositions(BufferType& Buffer, const FMeshView& Mesh, int32_t Begin, int32_t End, int32_t Precision)
+{
+    for (int32_t i = Begin; i < End; i++) {
+        Buffer.Commit(WriteVertex(Buffer.Reserve(MaxVertexChars), Mesh.Positions + 3 * i, Precision));
+    }
+}
+
+template <typename BufferType>
+void AppendTexCoords(BufferType& Buffer, const FMeshView& Mesh, int32_t Begin, int32_t End, int32_t Precision)
+{
+    for (int32_t i = Begin; i < End; i++) {
+        Buffer.Commit(WriteTexCoord(Buffer.Reserve(MaxTexCoordChars), Mesh.UVs + 2 * i, Precision));
+    }
+}
+
+template <typename BufferType>
+void AppendNormals(BufferType& Buffer, const FMeshView& Mesh, int32_t Begin, int32_t End, int32_t Precision)
+{
+    for (int32_t i = Begin; i < End; i++) {
+        Buffer.Commit(WriteNormal(Buffer.Reserve(MaxVertexChars), Mesh.Normals + 3 * i, Precision));
+    }
+}
+
+/** Faces with 1 based indices, preceded by "usemtl name\n" at every material switch inside the range. */
+template <typename BufferType>
+void AppendFaces(BufferType& Buffer, const FMeshView& Mesh, int32_t Begin, int32_t End)
+{
+    int32_t count = (int32_t)(std::lower_bound(Mesh.MaterialTriangles, Mesh.MaterialTriangles + Mesh.NumMaterials, Begin) - Mesh.MaterialTriangles);
+    for (int32_t i = Begin; i < End; i++) {
+        if (count < Mesh.NumMaterials && i == Mesh.MaterialTriangles[count]) {
+            AppendText(Buffer, "usemtl ", 7);
+            AppendText(Buffer, Mesh.MaterialNames[count], std::strlen(Mesh.MaterialNames[count]));
+            AppendText(Buffer, "\n", 1);
+            count++;
+        }
+
+        const uint32_t* Corners = Mesh.Indices + 3 * i;
+        uint32_t        P[3];
+        uint32_t        T[3];
+        uint32_t        N[3];
+        for (int32_t Corner = 0; Corner < 3; Corner++) {
+            P[Corner] = (Mesh.PositionRemap ? Mesh.PositionRemap[Corners[Corner]] : Corners[Corner]) + 1;
+            T[Corner] = (Mesh.UVRemap ? Mesh.UVRemap[Corners[Corner]] : Corners[Corner]) + 1;
+            N[Corner] = (Mesh.NormalRemap ? Mesh.NormalRemap[Corners[Corner]] : Corners[Corner]) + 1;
+        }
+        Buffer.Commit(WriteFace(Buffer.Reserve(MaxFaceChars), P, T, N));
+    }
+}
+
+/** File header up to the first position, MtlLibName is the mtl file name without directory. */
+template <typename BufferType>
+void AppendHeader(BufferType& Buffer, const char* MtlLibName)
+{
+    static const char Header[] = "# UnrealEd OBJ exporter\r\n\r\nmtllib ";
+    AppendText(Buffer, Header, sizeof(Header) - 1);
+    AppendText(Buffer, MtlLibName, std::strlen(MtlLibName));
+    AppendText(Buffer, "\n", 1);
+}
+
+template <typename BufferType>
+void AppendFooter(BufferType& Buffer)
+{
+    static const char Footer[] = "# UnrealEd OBJ exporter\r\n";
+    AppendText(Buffer, Footer, sizeof(Footer) - 1);
+}
+
+/** The whole file on the calling thread, block by block in the order the plugin writes them. */
+template <typename BufferType>
+void AppendObj(BufferType& Buffer, const FMeshView& Mesh, const char* MtlLibName, int32_t Precision)
+{
+    AppendHeader(Buffer, MtlLibName);
+    AppendPositions(Buffer, Mesh, 0, Mesh.NumPositions, Precision);
+    AppendText(Buffer, "\r\n", 2);
+    AppendTexCoords(Buffer, Mesh, 0, Mesh.NumUVs, Precision);
+    AppendText(Buffer, "\r\n", 2);
+    AppendNormals(Buffer, Mesh, 0, Mesh.NumNormals, Precision);
+    AppendFaces(Buffer, Mesh, 0, Mesh.NumIndices / 3);
+    AppendFooter(Buffer);
+}
+}  // namespace GetModelObj
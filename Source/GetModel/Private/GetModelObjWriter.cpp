@@ -0,0 +1,132 @@
+// Copyright 1998-2019 Epic Games, Inc. All Rights Reserved.
+
+#include "GetModelObjWriter.h"
+
+#include "GetModelAsyncFileWriter.h"
+#include "GetModelVertexWelder.h"
+#include "Misc/Paths.h"
+
+FGetModelObjBuffer::FGetModelObjBuffer(int32 InPrecision)
+    : Precision(GetModelObj::ClampPrecision(InPrecision))
+{
+}
+
+void FGetModelObjBuffer::AppendString(const FString& Text)
+{
+    // Same narrowing FArchive::Logf applies to every character.
+    const int32 Start = Data.AddUninitialized(Text.Len());
+    for (int32 i = 0; i < Text.Len(); i++) {
+        Data[Start + i] = CharCast<ANSICHAR>(Text[i]);
+    }
+}
+
+FGetModelObjWriter::FGetModelObjWriter(FGetModelAsyncFileWriter* InFile, int32 InPrecision, int32 InBlockSize)
+    : FGetModelObjBuffer(InPrecision)
+    , File(InFile)
+    , BlockSize(InBlockSize)
+{
+    // Leave room for the line that pushes the buffer over the block size.
+    Data.Reserve(BlockSize + 256);
+}
+
+FGetModelObjWriter::~FGetModelObjWriter()
+{
+    WriteBlock(Data);
+}
+
+void FGetModelObjWriter::Flush()
+{
+    WriteBlock(Data);
+    Data.Reserve(BlockSize + 256);
+}
+
+void FGetModelObjWriter::WriteBlock(TArray<ANSICHAR>& Block)
+{
+    if (File) {
+        File->Write(Block);
+    } else {
+        Block.Reset();
+    }
+}
+
+namespace
+{
+/** ANSI copies of a mesh's strings, kept alive while a GetModelObj::FMeshView points at them. */
+struct FAnsiStrings
+{
+    explicit FAnsiStrings(const TArray<FString>& Strings)
+    {
+        for (const FString& String : Strings) {
+            FGetModelObjBuffer& Buffer = Storage[Storage.AddDefaulted()];
+            Buffer.AppendString(String);
+            Buffer.Data.Add('\0');
+        }
+        for (const FGetModelObjBuffer& Buffer : Storage) {
+            Pointers.Add(Buffer.Data.GetData());
+        }
+    }
+
+    TArray<FGetModelObjBuffer> Storage;
+    TArray<const ANSICHAR*>    Pointers;
+};
+}  // namespace
+
+bool WriteObjFile(const FGetModelMeshSnapshot& Mesh, const FString& ObjPath, int32 FloatPrecision, const FGetModelWeldSettings* WeldSettings)
+{
+    static_assert(sizeof(FVector) == 3 * sizeof(float) && sizeof(FVector2D) == 2 * sizeof(float), "GetModelObj reads attributes as packed floats");
+
+    FGetModelAsyncFileWriter ObjFile(ObjPath);
+    if (!ObjFile.IsOpen()) {
+        return false;
+    }
+
+    {
+        // Optionally collapse duplicated attribute values, faces then index each attribute separately.
+        FGetModelWeldedMesh Welded;
+        if (WeldSettings) {
+            WeldVertexAttributes(Mesh.Positions, Mesh.UVs, Mesh.Normals, *WeldSettings, Welded);
+        }
+        const TArray<FVector>&   OutPositions = WeldSettings ? Welded.Positions : Mesh.Positions;
+        const TArray<FVector2D>& OutUVs       = WeldSettings ? Welded.UVs : Mesh.UVs;
+        const TArray<FVector>&   OutNormals   = WeldSettings ? Welded.Normals : Mesh.Normals;
+
+        const FAnsiStrings MaterialNames(Mesh.MaterialNames);
+        const FAnsiStrings MtlLibName(TArray<FString>{FPaths::GetCleanFilename(ObjPath)});
+
+        GetModelObj::FMeshView View;
+        View.Positions         = (const float*)OutPositions.GetData();
+        View.NumPositions      = OutPositions.Num();
+        View.UVs               = (const float*)OutUVs.GetData();
+        View.NumUVs            = OutUVs.Num();
+        View.Normals           = (const float*)OutNormals.GetData();
+        View.NumNormals        = OutNormals.Num();
+        View.Indices           = Mesh.Indices.GetData();
+        View.NumIndices        = Mesh.Indices.Num();
+        View.PositionRemap     = WeldSettings ? Welded.PositionRemap.GetData() : nullptr;
+        View.UVRemap           = WeldSettings ? Welded.UVRemap.GetData() : nullptr;
+        View.NormalRemap       = WeldSettings ? Welded.NormalRemap.GetData() : nullptr;
+        View.MaterialTriangles = Mesh.MaterialTriangles.GetData();
+        View.MaterialNames     = MaterialNames.Pointers.GetData();
+        View.NumMaterials      = Mesh.MaterialTriangles.Num();
+
+        // Lines are formatted into one large buffer and handed to the archive in blocks. Each block below is split
+        // into ranges that are formatted on worker threads and written back in order.
+        FGetModelObjWriter ObjWriter(&ObjFile, FloatPrecision);
+        const int32        Precision = ObjWriter.GetPrecision();
+        GetModelObj::AppendHeader(ObjWriter, MtlLibName.Pointers[0]);
+
+        ObjWriter.ParallelAppend(View.NumPositions, [&View, Precision](FGetModelObjBuffer& Buffer, int32 Begin, int32 End) { GetModelObj::AppendPositions(Buffer, View, Begin, End, Precision); });
+        GetModelObj::AppendText(ObjWriter, "\r\n", 2);
+
+        ObjWriter.ParallelAppend(View.NumUVs, [&View, Precision](FGetModelObjBuffer& Buffer, int32 Begin, int32 End) { GetModelObj::AppendTexCoords(Buffer, View, Begin, End, Precision); });
+        GetModelObj::AppendText(ObjWriter, "\r\n", 2);
+
+        ObjWriter.ParallelAppend(View.NumNormals, [&View, Precision](FGetModelObjBuffer& Buffer, int32 Begin, int32 End) { GetModelObj::AppendNormals(Buffer, View, Begin, End, Precision); });
+
+        ObjWriter.ParallelAppend(View.NumIndices / 3, [&View](FGetModelObjBuffer& Buffer, int32 Begin, int32 End) { GetModelObj::AppendFaces(Buffer, View, Begin, End); });
+
+        GetModelObj::AppendFooter(ObjWriter);
+    }
+
+    return ObjFile.Close();
+}
@@ -0,0 +1,129 @@
+// Copyright 1998-2019 Epic Games, Inc. All Rights Reserved.
+
+#pragma once
+
+#include "Async/ParallelFor.h"
+#include "CoreMinimal.h"
+#include "GetModelObjFormat.h"
+
+class FGetModelAsyncFileWriter;
+struct FGetModelWeldSettings;
+
+/**
+ * One mesh LOD copied out of its render data, already in obj space (Y/Z swapped, v flipped). It owns everything
+ * WriteObjFile needs, so it can be handed to a worker thread.
+ */
+struct FGetModelMeshSnapshot
+{
+    TArray<FVector>   Positions;
+    TArray<FVector2D> UVs;
+    TArray<FVector>   Normals;
+    TArray<uint32>    Indices;
+
+    /** Triangle at which each usemtl line goes and the material name it switches to. */
+    TArray<int32>   MaterialTriangles;
+    TArray<FString> MaterialNames;
+};
+
+/**
+ * Growable ANSI text buffer the engine independent GetModelObj formatters write into (see GetModelObjFormat.h).
+ * Precision >= 0 gives the same digits as printf "%.*f", a negative precision writes the shortest text that reads back to the same float.
+ */
+class FGetModelObjBuffer
+{
+public:
+    explicit FGetModelObjBuffer(int32 InPrecision = 6);
+
+    /** Room for at least MaxChars past the end of Data, grown geometrically so per-line calls stay amortized. */
+    ANSICHAR* Reserve(int32 MaxChars)
+    {
+        if (Data.Num() + MaxChars > Data.Max()) {
+            Data.Reserve(FMath::Max(Data.Max() * 2, Data.Num() + MaxChars));
+        }
+        return Data.GetData() + Data.Num();
+    }
+
+    /** Keeps what was written since Reserve up to End. */
+    void Commit(ANSICHAR* End)
+    {
+        Data.SetNumUninitialized(End - Data.GetData(), false);
+    }
+
+    void AppendString(const FString& Text);
+
+    int32 GetPrecision() const { return Precision; }
+
+public:
+    TArray<ANSICHAR> Data;
+
+private:
+    int32 Precision;
+};
+
+/**
+ * Buffers OBJ text and hands it to the file in large blocks instead of one small write per line. Blocks are written
+ * in the background, so the next one is formatted while the previous ones are still going to disk.
+ */
+class FGetModelObjWriter : public FGetModelObjBuffer
+{
+public:
+    static const int32 DefaultBlockSize = 4 * 1024 * 1024;
+
+    FGetModelObjWriter(FGetModelAsyncFileWriter* InFile, int32 InPrecision = 6, int32 InBlockSize = DefaultBlockSize);
+    ~FGetModelObjWriter();
+
+    /** Writes the buffered text once it has grown past the block size. */
+    void FlushIfFull()
+    {
+        if (Data.Num() >= BlockSize) {
+            Flush();
+        }
+    }
+
+    void Flush();
+
+    /**
+     * Formats items [0, Num) in fixed-size ranges on worker threads, each range into its own buffer, and writes the
+     * buffers in range order so the output is identical to formatting the items one after another.
+     * Format is called as Format(FGetModelObjBuffer& Buffer, int32 Begin, int32 End).
+     */
+    template <typename FormatFunc>
+    void ParallelAppend(int32 Num, FormatFunc Format, int32 RangeSize = DefaultRangeSize)
+    {
+        const int32 NumRanges = FMath::DivideAndRoundUp(Num, RangeSize);
+        if (NumRanges <= 1) {
+            Format(*this, 0, Num);
+            FlushIfFull();
+            return;
+        }
+
+        // Ranges are formatted in waves so at most MaxRangesInFlight buffers are alive at a time.
+        Flush();
+        TArray<FGetModelObjBuffer> Buffers;
+        Buffers.Init(FGetModelObjBuffer(GetPrecision()), FMath::Min(NumRanges, MaxRangesInFlight));
+        for (int32 WaveStart = 0; WaveStart < NumRanges; WaveStart += Buffers.Num()) {
+            const int32 WaveCount = FMath::Min(Buffers.Num(), NumRanges - WaveStart);
+            ParallelFor(WaveCount, [&](int32 WaveIndex) {
+                const int32 Begin = (WaveStart + WaveIndex) * RangeSize;
+                Buffers[WaveIndex].Data.Reset();
+                Format(Buffers[WaveIndex], Begin, FMath::Min(Begin + RangeSize, Num));
+            });
+            for (int32 WaveIndex = 0; WaveIndex < WaveCount; WaveIndex++) {
+                WriteBlock(Buffers[WaveIndex].Data);
+            }
+        }
+    }
+
+    static const int32 DefaultRangeSize  = 16 * 1024;
+    static const int32 MaxRangesInFlight = 128;
+
+private:
+    /** Hands Block to the file and leaves an empty buffer in its place. */
+    void WriteBlock(TArray<ANSICHAR>& Block);
+
+    FGetModelAsyncFileWriter* File;
+    int32                     BlockSize;
+};
+
+/** Writes Mesh to ObjPath, optionally welding its attributes first. Safe to call from any thread. */
+bool WriteObjFile(const FGetModelMeshSnapshot& Mesh, const FString& ObjPath, int32 FloatPrecision, const FGetModelWeldSettings* WeldSettings);
@@ -0,0 +1,192 @@
+// Copyright 1998-2019 Epic Games, Inc. All Rights Reserved.
+
+#include "GetModelQuantizedWriter.h"
+
+#include "Async/ParallelFor.h"
+#include "GetModelAsyncFileWriter.h"
+#include "GetModelMeshCodec.h"
+
+namespace
+{
+const uint32 QuantizedVersion = 1;
+
+enum EQuantizedStream
+{
+    Stream_Positions,
+    Stream_Normals,
+    Stream_UVs,
+    Stream_Indices,
+    Stream_Count
+};
+
+void AppendBytes(TArray<ANSICHAR>& Out, const void* Data, int32 Size)
+{
+    Out.Append((const ANSICHAR*)Data, Size);
+}
+
+template <typename T>
+void AppendValue(TArray<ANSICHAR>& Out, const T& Value)
+{
+    AppendBytes(Out, &Value, sizeof(T));
+}
+
+uint16 QuantizeUnorm16(float Value, float Min, float Scale)
+{
+    return (uint16)FMath::Clamp(FMath::RoundToInt((Value - Min) * Scale), 0, 65535);
+}
+
+/** Octahedral mapping of N onto [-1, 1]^2, as documented in the header. */
+FVector2D EncodeOctahedral(const FVector& N)
+{
+    const float L1 = FMath::Abs(N.X) + FMath::Abs(N.Y) + FMath::Abs(N.Z);
+    if (L1 <= SMALL_NUMBER) {
+        return FVector2D(0.0f, 0.0f);
+    }
+
+    FVector2D P(N.X / L1, N.Y / L1);
+    if (N.Z < 0.0f) {
+        P = FVector2D((1.0f - FMath::Abs(P.Y)) * (P.X >= 0.0f ? 1.0f : -1.0f), (1.0f - FMath::Abs(P.X)) * (P.Y >= 0.0f ? 1.0f : -1.0f));
+    }
+    return P;
+}
+
+template <typename T>
+void QuantizeNormals(const TArray<FVector>& Normals, TArray<uint8>& OutStream)
+{
+    const float MaxValue = (float)TNumericLimits<T>::Max();
+
+    OutStream.SetNumUninitialized(Normals.Num() * 2 * sizeof(T));
+    T* Out = (T*)OutStream.GetData();
+    for (int32 i = 0; i < Normals.Num(); i++) {
+        const FVector2D P = EncodeOctahedral(Normals[i]);
+        Out[i * 2 + 0]    = (T)FMath::RoundToInt(FMath::Clamp(P.X, -1.0f, 1.0f) * MaxValue);
+        Out[i * 2 + 1]    = (T)FMath::RoundToInt(FMath::Clamp(P.Y, -1.0f, 1.0f) * MaxValue);
+    }
+}
+
+struct FQuantizedSection
+{
+    uint32  FirstIndex;
+    uint32  NumIndices;
+    FString Name;
+};
+
+TArray<FQuantizedSection> GetSections(const FGetModelMeshSnapshot& Mesh)
+{
+    // Triangles before the first usemtl keep no material, like in the obj.
+    TArray<FQuantizedSection> Sections;
+    const int32               NumTriangles = Mesh.Indices.Num() / 3;
+    int32                     Start        = 0;
+    FString                   Name;
+    for (int32 Material = 0; Material <= Mesh.MaterialTriangles.Num(); Material++) {
+        const int32 End = Material < Mesh.MaterialTriangles.Num() ? FMath::Min(Mesh.MaterialTriangles[Material], NumTriangles) : NumTriangles;
+        if (End > Start || (Material == Mesh.MaterialTriangles.Num() && Sections.Num() == 0)) {
+            Sections.Add({(uint32)Start * 3, (uint32)(End - Start) * 3, Name});
+        }
+        if (Material < Mesh.MaterialTriangles.Num()) {
+            Start = FMath::Max(Start, End);
+            Name  = Mesh.MaterialNames[Material];
+        }
+    }
+    return Sections;
+}
+}  // namespace
+
+bool WriteQuantizedMeshFile(const FGetModelMeshSnapshot& Mesh, const FString& Path, const FGetModelQuantizeSettings& Settings)
+{
+    const int32 NumVertices = Mesh.Positions.Num();
+    const int32 NormalBits  = Settings.NormalBits > 8 ? 16 : 8;
+
+    const FBox    Bounds         = NumVertices ? FBox(Mesh.Positions) : FBox(FVector::ZeroVector, FVector::ZeroVector);
+    const FVector PositionMin    = Bounds.Min;
+    const FVector PositionExtent = Bounds.Max - Bounds.Min;
+
+    FVector2D UVMin(0.0f, 0.0f);
+    FVector2D UVMax(0.0f, 0.0f);
+    if (Mesh.UVs.Num()) {
+        UVMin = UVMax = Mesh.UVs[0];
+        for (const FVector2D& UV : Mesh.UVs) {
+            UVMin = FVector2D::Min(UVMin, UV);
+            UVMax = FVector2D::Max(UVMax, UV);
+        }
+    }
+    const FVector2D UVExtent = UVMax - UVMin;
+
+    // Raw quantized streams, one per attribute so each byte plane holds like values.
+    TArray<uint8> Raw[Stream_Count];
+    Raw[Stream_Positions].SetNumUninitialized(NumVertices * 3 * sizeof(uint16));
+    Raw[Stream_UVs].SetNumZeroed(NumVertices * 2 * sizeof(uint16));
+    {
+        const FVector Scale(PositionExtent.X > 0.0f ? 65535.0f / PositionExtent.X : 0.0f,
+                            PositionExtent.Y > 0.0f ? 65535.0f / PositionExtent.Y : 0.0f,
+                            PositionExtent.Z > 0.0f ? 65535.0f / PositionExtent.Z : 0.0f);
+        uint16* Out = (uint16*)Raw[Stream_Positions].GetData();
+        for (int32 i = 0; i < NumVertices; i++) {
+            const FVector& P = Mesh.Positions[i];
+            Out[i * 3 + 0]   = QuantizeUnorm16(P.X, PositionMin.X, Scale.X);
+            Out[i * 3 + 1]   = QuantizeUnorm16(P.Y, PositionMin.Y, Scale.Y);
+            Out[i * 3 + 2]   = QuantizeUnorm16(P.Z, PositionMin.Z, Scale.Z);
+        }
+    }
+    {
+        const FVector2D Scale(UVExtent.X > 0.0f ? 65535.0f / UVExtent.X : 0.0f, UVExtent.Y > 0.0f ? 65535.0f / UVExtent.Y : 0.0f);
+        uint16* Out = (uint16*)Raw[Stream_UVs].GetData();
+        for (int32 i = 0; i < FMath::Min(NumVertices, Mesh.UVs.Num()); i++) {
+            Out[i * 2 + 0] = QuantizeUnorm16(Mesh.UVs[i].X, UVMin.X, Scale.X);
+            Out[i * 2 + 1] = QuantizeUnorm16(Mesh.UVs[i].Y, UVMin.Y, Scale.Y);
+        }
+    }
+    TArray<FVector> Normals = Mesh.Normals;
+    Normals.SetNumZeroed(NumVertices);
+    if (NormalBits == 16) {
+        QuantizeNormals<int16>(Normals, Raw[Stream_Normals]);
+    } else {
+        QuantizeNormals<int8>(Normals, Raw[Stream_Normals]);
+    }
+
+    // Bytes per vertex: uint16 x3, two 8 or 16 bit components, uint16 x2; indices have their own encoding.
+    const int32 Strides[Stream_Count] = {6, NormalBits / 4, 4, 0};
+
+    TArray<uint8> Encoded[Stream_Count];
+    ParallelFor(Stream_Count, [&](int32 Stream) {
+        if (Stream == Stream_Indices) {
+            Encoded[Stream].SetNumUninitialized(GetModelCodec::GetIndexStreamBound(Mesh.Indices.Num()));
+            Encoded[Stream].SetNum(GetModelCodec::EncodeIndexStream(Encoded[Stream].GetData(), Mesh.Indices.GetData(), Mesh.Indices.Num()), false);
+        } else {
+            Encoded[Stream].SetNumUninitialized(GetModelCodec::GetVertexStreamBound(NumVertices, Strides[Stream]));
+            Encoded[Stream].SetNum(GetModelCodec::EncodeVertexStream(Encoded[Stream].GetData(), Raw[Stream].GetData(), NumVertices, Strides[Stream]), false);
+        }
+    });
+
+    const TArray<FQuantizedSection> Sections = GetSections(Mesh);
+
+    TArray<ANSICHAR> File;
+    AppendBytes(File, "GMQ1", 4);
+    AppendValue(File, QuantizedVersion);
+    AppendValue(File, (uint32)NumVertices);
+    AppendValue(File, (uint32)Mesh.Indices.Num());
+    AppendValue(File, (uint32)Sections.Num());
+    AppendValue(File, (uint32)NormalBits);
+    AppendValue(File, PositionMin);
+    AppendValue(File, PositionExtent);
+    AppendValue(File, UVMin);
+    AppendValue(File, UVExtent);
+    for (const TArray<uint8>& Stream : Encoded) {
+        AppendValue(File, (uint32)Stream.Num());
+    }
+    for (const FQuantizedSection& Section : Sections) {
+        AppendValue(File, Section.FirstIndex);
+        AppendValue(File, Section.NumIndices);
+        const auto Name = StringCast<ANSICHAR>(*Section.Name);
+        AppendValue(File, (uint16)Name.Length());
+        AppendBytes(File, Name.Get(), Name.Length());
+    }
+    for (const TArray<uint8>& Stream : Encoded) {
+        AppendBytes(File, Stream.GetData(), Stream.Num());
+    }
+
+    FGetModelAsyncFileWriter QuantizedFile(Path, 1);
+    QuantizedFile.Preallocate(File.Num());
+    QuantizedFile.Write(File);
+    return QuantizedFile.Close();
+}
@@ -0,0 +1,29 @@
+// Copyright 1998-2019 Epic Games, Inc. All Rights Reserved.
+
+#pragma once
+
+#include "CoreMinimal.h"
+#include "GetModelObjWriter.h"
+
+/** How WriteQuantizedMeshFile stores normals, everything else is fixed. */
+struct FGetModelQuantizeSettings
+{
+    /** Bits per octahedral component, 8 or 16. */
+    int32 NormalBits = 8;
+};
+
+/**
+ * Writes Mesh as a compact binary .gmq next to where the obj would go, in the same space as the obj. All values are
+ * little endian:
+ *
+ *   char[4] "GMQ1", uint32 version (1), uint32 vertex count, uint32 index count, uint32 section count, uint32 normal bits
+ *   float[3] position min, float[3] position extent     position = min + q / 65535 * extent, q uint16 x3
+ *   float[2] uv min, float[2] uv extent                 uv = min + q / 65535 * extent, q uint16 x2
+ *   uint32[4] encoded bytes of the position, normal, uv and index streams
+ *   per section: uint32 first index, uint32 index count, uint16 name length, name (ANSI, no terminator)
+ *   the four streams, encoded with GetModelCodec (vertex strides 6, 2 or 4 for 8 or 16 bit normals, and 4)
+ *
+ * Normals are octahedral signed normalized pairs: n = (x, y, 1 - |x| - |y|), folded by x' = (1 - |y|) * sign(x),
+ * y' = (1 - |x|) * sign(y) where the third component is negative, then normalized. Safe to call from any thread.
+ */
+bool WriteQuantizedMeshFile(const FGetModelMeshSnapshot& Mesh, const FString& Path, const FGetModelQuantizeSettings& Settings);
@@ -0,0 +1,151 @@
+// Copyright 1998-2019 Epic Games, Inc. All Rights Reserved.
+
+#include "GetModelTextureEncoder.h"
+
+#include "Engine/Texture2D.h"
+#include "IImageWrapper.h"
+#include "IImageWrapperModule.h"
+#include "Modules/ModuleManager.h"
+
+namespace
+{
+template <typename T>
+void AppendValue(TArray<uint8>& Bytes, T Value)
+{
+    Bytes.Append((const uint8*)&Value, sizeof(T));
+}
+
+// Run-length encoded 32 bit targa with a top-left origin. Baked maps have large flat areas, which RLE packs well.
+void EncodeTga(const FGetModelTextureSnapshot& Snapshot, TArray<uint8>& OutBytes)
+{
+    const uint8 Header[18] = {0, 0, 10, 0, 0, 0, 0, 0, 0, 0, 0, 0, (uint8)(Snapshot.SizeX & 0xFF), (uint8)(Snapshot.SizeX >> 8), (uint8)(Snapshot.SizeY & 0xFF), (uint8)(Snapshot.SizeY >> 8), 32, 0x28};
+
+    OutBytes.Reset(sizeof(Header) + Snapshot.Pixels.Num() * 2);
+    OutBytes.Append(Header, sizeof(Header));
+
+    // Packets never cross a scanline, as the format recommends.
+    for (int32 Y = 0; Y < Snapshot.SizeY; Y++) {
+        const FColor* Row = Snapshot.Pixels.GetData() + Y * Snapshot.SizeX;
+        int32         X   = 0;
+        while (X < Snapshot.SizeX) {
+            int32 Run = 1;
+            while (X + Run < Snapshot.SizeX && Run < 128 && Row[X + Run] == Row[X]) {
+                Run++;
+            }
+
+            if (Run > 1) {
+                OutBytes.Add(0x80 | (Run - 1));
+                AppendValue(OutBytes, Row[X]);
+                X += Run;
+                continue;
+            }
+
+            // Raw packet up to the next pair of equal pixels.
+            int32 Raw = 1;
+            while (X + Raw < Snapshot.SizeX && Raw < 128 && !(X + Raw + 1 < Snapshot.SizeX && Row[X + Raw] == Row[X + Raw + 1])) {
+                Raw++;
+            }
+            OutBytes.Add(Raw - 1);
+            OutBytes.Append((const uint8*)(Row + X), Raw * sizeof(FColor));
+            X += Raw;
+        }
+    }
+}
+
+bool EncodeWithImageWrapper(const FGetModelTextureSnapshot& Snapshot, EImageFormat ImageFormat, EGetModelTextureFormat Format, TArray<uint8>& OutBytes)
+{
+    IImageWrapperModule&      ImageWrapperModule = FModuleManager::GetModuleChecked<IImageWrapperModule>(FName("ImageWrapper"));
+    TSharedPtr<IImageWrapper> ImageWrapper       = ImageWrapperModule.CreateImageWrapper(ImageFormat);
+    if (!ImageWrapper.IsValid()) {
+        return false;
+    }
+
+    bool bRawSet = false;
+    if (Format == EGetModelTextureFormat::PNG16) {
+        TArray<uint16> Wide;
+        Wide.SetNumUninitialized(Snapshot.Pixels.Num() * 4);
+        for (int32 i = 0; i < Snapshot.Pixels.Num(); i++) {
+            // x * 257 maps 255 to 65535 exactly.
+            Wide[i * 4 + 0] = Snapshot.Pixels[i].R * 257;
+            Wide[i * 4 + 1] = Snapshot.Pixels[i].G * 257;
+            Wide[i * 4 + 2] = Snapshot.Pixels[i].B * 257;
+            Wide[i * 4 + 3] = Snapshot.Pixels[i].A * 257;
+        }
+        bRawSet = ImageWrapper->SetRaw(Wide.GetData(), Wide.Num() * sizeof(uint16), Snapshot.SizeX, Snapshot.SizeY, ERGBFormat::RGBA, 16);
+    } else if (Format == EGetModelTextureFormat::EXR) {
+        TArray<FLinearColor> Floats;
+        Floats.SetNumUninitialized(Snapshot.Pixels.Num());
+        for (int32 i = 0; i < Snapshot.Pixels.Num(); i++) {
+            // Encoded values as stored, no sRGB conversion; consumers decode normals the same way as from the png.
+            Floats[i] = Snapshot.Pixels[i].ReinterpretAsLinear();
+        }
+        bRawSet = ImageWrapper->SetRaw(Floats.GetData(), Floats.Num() * sizeof(FLinearColor), Snapshot.SizeX, Snapshot.SizeY, ERGBFormat::RGBA, 32);
+    } else {
+        bRawSet = ImageWrapper->SetRaw(Snapshot.Pixels.GetData(), Snapshot.Pixels.Num() * sizeof(FColor), Snapshot.SizeX, Snapshot.SizeY, ERGBFormat::BGRA, 8);
+    }
+
+    if (!bRawSet) {
+        return false;
+    }
+
+    OutBytes = ImageWrapper->GetCompressed();
+    return OutBytes.Num() > 0;
+}
+}  // namespace
+
+const TCHAR* GetTextureFormatExtension(EGetModelTextureFormat Format)
+{
+    switch (Format) {
+        case EGetModelTextureFormat::PNG:
+        case EGetModelTextureFormat::PNG16:
+            return TEXT("png");
+        case EGetModelTextureFormat::TGA:
+            return TEXT("tga");
+        case EGetModelTextureFormat::EXR:
+            return TEXT("exr");
+        default:
+            return TEXT("bmp");
+    }
+}
+
+const TArray<FString>& GetTextureFormatNames()
+{
+    static const TArray<FString> Names = {TEXT("BMP"), TEXT("PNG"), TEXT("PNG 16 bit"), TEXT("TGA"), TEXT("EXR")};
+    return Names;
+}
+
+bool SnapshotTexture(UTexture2D* Texture, FGetModelTextureSnapshot& OutSnapshot)
+{
+    check(IsInGameThread());
+
+    // Load it here so worker threads only ever look the module up.
+    FModuleManager::LoadModuleChecked<IImageWrapperModule>(FName("ImageWrapper"));
+
+    TArray<uint8> MipData;
+    if (!Texture || Texture->Source.GetFormat() != TSF_BGRA8 || !Texture->Source.GetMipData(MipData, 0)) {
+        return false;
+    }
+
+    OutSnapshot.Name  = Texture->GetName();
+    OutSnapshot.SizeX = Texture->Source.GetSizeX();
+    OutSnapshot.SizeY = Texture->Source.GetSizeY();
+    OutSnapshot.Pixels.SetNumUninitialized(OutSnapshot.SizeX * OutSnapshot.SizeY);
+    FMemory::Memcpy(OutSnapshot.Pixels.GetData(), MipData.GetData(), FMath::Min<int64>(MipData.Num(), OutSnapshot.Pixels.Num() * sizeof(FColor)));
+    return true;
+}
+
+bool EncodeTexture(const FGetModelTextureSnapshot& Snapshot, EGetModelTextureFormat Format, TArray<uint8>& OutBytes)
+{
+    switch (Format) {
+        case EGetModelTextureFormat::BMP:
+            // Bitmaps keep going through the engine's exporter on the game thread.
+            return false;
+        case EGetModelTextureFormat::TGA:
+            EncodeTga(Snapshot, OutBytes);
+            return true;
+        case EGetModelTextureFormat::EXR:
+            return EncodeWithImageWrapper(Snapshot, EImageFormat::EXR, Format, OutBytes);
+        default:
+            return EncodeWithImageWrapper(Snapshot, EImageFormat::PNG, Format, OutBytes);
+    }
+}
@@ -0,0 +1,38 @@
+// Copyright 1998-2019 Epic Games, Inc. All Rights Reserved.
+
+#pragma once
+
+#include "CoreMinimal.h"
+
+class UTexture2D;
+
+/** File format of exported baked maps. PNG16 and EXR widen the 8 bit bake, which some normal map consumers require. */
+enum class EGetModelTextureFormat : uint8
+{
+    BMP,
+    PNG,
+    PNG16,
+    TGA,
+    EXR,
+};
+
+/** File extension without dot, e.g. "png". */
+const TCHAR* GetTextureFormatExtension(EGetModelTextureFormat Format);
+
+/** Display names in enum order, for the format pickers. */
+const TArray<FString>& GetTextureFormatNames();
+
+/** Pixels of a baked map copied out of the UTexture2D source, so they can be encoded away from the game thread. */
+struct FGetModelTextureSnapshot
+{
+    FString        Name;
+    int32          SizeX = 0;
+    int32          SizeY = 0;
+    TArray<FColor> Pixels;
+};
+
+/** Game thread only: reads mip 0 of a BGRA8 source texture. */
+bool SnapshotTexture(UTexture2D* Texture, FGetModelTextureSnapshot& OutSnapshot);
+
+/** Thread-safe: encodes a snapshot into the bytes of a file of the given format. BMP is left to the engine's UExporter. */
+bool EncodeTexture(const FGetModelTextureSnapshot& Snapshot, EGetModelTextureFormat Format, TArray<uint8>& OutBytes);
@@ -0,0 +1,286 @@
+// Copyright 1998-2019 Epic Games, Inc. All Rights Reserved.
+
+#include "GetModelUVTransfer.h"
+
+#include "Async/ParallelFor.h"
+
+namespace
+{
+/** Source triangles bucketed in a sparse uniform grid, a triangle is listed in every cell its bounds overlap. */
+class FTriangleGrid
+{
+public:
+    explicit FTriangleGrid(const FGetModelMeshSnapshot& InMesh)
+        : Mesh(InMesh)
+        , MinCell(MAX_int32)
+        , MaxCell(MIN_int32)
+    {
+        const int32 NumTriangles = Mesh.Indices.Num() / 3;
+        Normals.SetNumZeroed(NumTriangles);
+        BuildCharts();
+
+        // Cells about twice the mean triangle size keep both the lists and the rings short; a few very large
+        // triangles must not spread over too many cells though.
+        float ExtentSum = 0.0f;
+        float ExtentMax = 0.0f;
+        int32 NumValid  = 0;
+        for (int32 Triangle = 0; Triangle < NumTriangles; Triangle++) {
+            const FVector& A = Corner(Triangle, 0);
+            const FVector& B = Corner(Triangle, 1);
+            const FVector& C = Corner(Triangle, 2);
+
+            if (((B - A) ^ (C - A)).SizeSquared() <= SMALL_NUMBER) {
+                continue;
+            }
+            // Facing from the vertex normals rather than the winding, the axis swap into obj space mirrors the latter.
+            Normals[Triangle] = CornerNormal(Triangle, 0) + CornerNormal(Triangle, 1) + CornerNormal(Triangle, 2);
+
+            FBox TriangleBox(ForceInit);
+            TriangleBox += A;
+            TriangleBox += B;
+            TriangleBox += C;
+            ExtentSum += TriangleBox.GetSize().GetMax();
+            ExtentMax  = FMath::Max(ExtentMax, TriangleBox.GetSize().GetMax());
+            NumValid++;
+        }
+
+        CellSize = NumValid ? FMath::Max3(2.0f * ExtentSum / NumValid, ExtentMax / 32.0f, KINDA_SMALL_NUMBER) : 1.0f;
+
+        for (int32 Triangle = 0; Triangle < NumTriangles; Triangle++) {
+            if (Normals[Triangle].IsZero()) {
+                continue;
+            }
+
+            FBox TriangleBox(ForceInit);
+            TriangleBox += Corner(Triangle, 0);
+            TriangleBox += Corner(Triangle, 1);
+            TriangleBox += Corner(Triangle, 2);
+
+            const FIntVector Min = ToCell(TriangleBox.Min);
+            const FIntVector Max = ToCell(TriangleBox.Max);
+            for (int32 Z = Min.Z; Z <= Max.Z; Z++) {
+                for (int32 Y = Min.Y; Y <= Max.Y; Y++) {
+                    for (int32 X = Min.X; X <= Max.X; X++) {
+                        Cells.FindOrAdd(FIntVector(X, Y, Z)).Add(Triangle);
+                    }
+                }
+            }
+
+            MinCell = FIntVector(FMath::Min(MinCell.X, Min.X), FMath::Min(MinCell.Y, Min.Y), FMath::Min(MinCell.Z, Min.Z));
+            MaxCell = FIntVector(FMath::Max(MaxCell.X, Max.X), FMath::Max(MaxCell.Y, Max.Y), FMath::Max(MaxCell.Z, Max.Z));
+        }
+    }
+
+    bool IsEmpty() const
+    {
+        return Cells.Num() == 0;
+    }
+
+    /**
+     * Uv of the closest surface point to Position, preferring triangles that face along Normal. Only triangles of
+     * Chart are searched unless it is INDEX_NONE; OutChart receives the chart of the point found.
+     */
+    FVector2D FindUV(const FVector& Position, const FVector& Normal, int32 Chart = INDEX_NONE, int32* OutChart = nullptr) const
+    {
+        FHit Facing;
+        FHit Any;
+
+        const FIntVector Center   = ToCell(Position);
+        const int32      MaxRings = FMath::Max3(FMath::Max(FMath::Abs(Center.X - MinCell.X), FMath::Abs(MaxCell.X - Center.X)), FMath::Max(FMath::Abs(Center.Y - MinCell.Y), FMath::Abs(MaxCell.Y - Center.Y)), FMath::Max(FMath::Abs(Center.Z - MinCell.Z), FMath::Abs(MaxCell.Z - Center.Z)));
+        for (int32 Ring = 0; Ring <= MaxRings; Ring++) {
+            // Anything in this ring or further is at least this far away.
+            const float RingDistance = (Ring - 1) * CellSize;
+            if (Facing.IsSet() && Facing.Distance <= RingDistance) {
+                break;
+            }
+            // A facing triangle much further than the closest one is not the same surface.
+            if (Any.IsSet() && RingDistance > 2.0f * Any.Distance + CellSize) {
+                break;
+            }
+
+            for (int32 Z = -Ring; Z <= Ring; Z++) {
+                for (int32 Y = -Ring; Y <= Ring; Y++) {
+                    for (int32 X = -Ring; X <= Ring; X++) {
+                        if (FMath::Max3(FMath::Abs(X), FMath::Abs(Y), FMath::Abs(Z)) != Ring) {
+                            continue;
+                        }
+
+                        const TArray<int32>* Triangles = Cells.Find(Center + FIntVector(X, Y, Z));
+                        if (!Triangles) {
+                            continue;
+                        }
+
+                        for (int32 Triangle : *Triangles) {
+                            if (Chart != INDEX_NONE && Charts[Triangle] != Chart) {
+                                continue;
+                            }
+
+                            const FVector Closest  = FMath::ClosestPointOnTriangleToPoint(Position, Corner(Triangle, 0), Corner(Triangle, 1), Corner(Triangle, 2));
+                            const float   Distance = FVector::Dist(Position, Closest);
+                            Any.Update(Triangle, Closest, Distance);
+                            if ((Normals[Triangle] | Normal) >= 0.0f) {
+                                Facing.Update(Triangle, Closest, Distance);
+                            }
+                        }
+                    }
+                }
+            }
+        }
+
+        const FHit& Hit = Facing.IsSet() && Facing.Distance <= 2.0f * Any.Distance + CellSize ? Facing : Any;
+        if (!Hit.IsSet()) {
+            return FVector2D::ZeroVector;
+        }
+        if (OutChart) {
+            *OutChart = Charts[Hit.Triangle];
+        }
+
+        const FVector Weights = FMath::ComputeBaryCentric2D(Hit.Point, Corner(Hit.Triangle, 0), Corner(Hit.Triangle, 1), Corner(Hit.Triangle, 2));
+        return CornerUV(Hit.Triangle, 0) * Weights.X + CornerUV(Hit.Triangle, 1) * Weights.Y + CornerUV(Hit.Triangle, 2) * Weights.Z;
+    }
+
+private:
+    struct FHit
+    {
+        int32   Triangle = INDEX_NONE;
+        FVector Point    = FVector::ZeroVector;
+        float   Distance = MAX_FLT;
+
+        bool IsSet() const
+        {
+            return Triangle != INDEX_NONE;
+        }
+
+        void Update(int32 InTriangle, const FVector& InPoint, float InDistance)
+        {
+            if (InDistance < Distance) {
+                Triangle = InTriangle;
+                Point    = InPoint;
+                Distance = InDistance;
+            }
+        }
+    };
+
+    /**
+     * Charts are the islands of the uv layout: triangles joined through corners with the same position and uv. The
+     * snapshot also splits vertices where only the normals differ, so equal vertices are joined first.
+     */
+    void BuildCharts()
+    {
+        TArray<int32> Parents;
+        Parents.SetNumUninitialized(Mesh.Positions.Num());
+        for (int32 Vertex = 0; Vertex < Parents.Num(); Vertex++) {
+            Parents[Vertex] = Vertex;
+        }
+
+        auto FindRoot = [&Parents](int32 Vertex) {
+            while (Parents[Vertex] != Vertex) {
+                Parents[Vertex] = Parents[Parents[Vertex]];
+                Vertex          = Parents[Vertex];
+            }
+            return Vertex;
+        };
+        auto Join = [&Parents, &FindRoot](int32 A, int32 B) {
+            A = FindRoot(A);
+            B = FindRoot(B);
+            if (A != B) {
+                Parents[FMath::Max(A, B)] = FMath::Min(A, B);
+            }
+        };
+
+        TMap<TTuple<FVector, FVector2D>, int32> FirstVertices;
+        for (int32 Vertex = 0; Vertex < Mesh.Positions.Num(); Vertex++) {
+            const TTuple<FVector, FVector2D> Key = MakeTuple(Mesh.Positions[Vertex], Mesh.UVs[Vertex]);
+            if (const int32* First = FirstVertices.Find(Key)) {
+                Join(*First, Vertex);
+            } else {
+                FirstVertices.Add(Key, Vertex);
+            }
+        }
+
+        const int32 NumTriangles = Mesh.Indices.Num() / 3;
+        for (int32 Triangle = 0; Triangle < NumTriangles; Triangle++) {
+            Join(Mesh.Indices[Triangle * 3], Mesh.Indices[Triangle * 3 + 1]);
+            Join(Mesh.Indices[Triangle * 3], Mesh.Indices[Triangle * 3 + 2]);
+        }
+
+        Charts.SetNumUninitialized(NumTriangles);
+        for (int32 Triangle = 0; Triangle < NumTriangles; Triangle++) {
+            Charts[Triangle] = FindRoot(Mesh.Indices[Triangle * 3]);
+        }
+    }
+
+    const FVector& Corner(int32 Triangle, int32 Index) const
+    {
+        return Mesh.Positions[Mesh.Indices[Triangle * 3 + Index]];
+    }
+
+    const FVector& CornerNormal(int32 Triangle, int32 Index) const
+    {
+        return Mesh.Normals[Mesh.Indices[Triangle * 3 + Index]];
+    }
+
+    const FVector2D& CornerUV(int32 Triangle, int32 Index) const
+    {
+        return Mesh.UVs[Mesh.Indices[Triangle * 3 + Index]];
+    }
+
+    FIntVector ToCell(const FVector& Position) const
+    {
+        return FIntVector(FMath::FloorToInt(Position.X / CellSize), FMath::FloorToInt(Position.Y / CellSize), FMath::FloorToInt(Position.Z / CellSize));
+    }
+
+    const FGetModelMeshSnapshot&    Mesh;
+    TArray<FVector>                 Normals;
+    TArray<int32>                   Charts;
+    TMap<FIntVector, TArray<int32>> Cells;
+    FIntVector                      MinCell;
+    FIntVector                      MaxCell;
+    float                           CellSize;
+};
+}  // namespace
+
+void TransferUVs(const FGetModelMeshSnapshot& Source, FGetModelMeshSnapshot& Target)
+{
+    const FTriangleGrid Grid(Source);
+    if (Grid.IsEmpty()) {
+        return;
+    }
+
+    TArray<int32> VertexCharts;
+    VertexCharts.SetNumUninitialized(Target.Positions.Num());
+    ParallelFor(Target.Positions.Num(), [&](int32 i) { Target.UVs[i] = Grid.FindUV(Target.Positions[i], Target.Normals[i], INDEX_NONE, &VertexCharts[i]); });
+
+    // A triangle whose corners landed on different charts would interpolate across the gaps of the atlas. It keeps
+    // the chart most of its corners are on, and each other corner gets a copy of its vertex with the closest uv on
+    // that chart, shared by the triangles around it that keep the same chart.
+    TMap<TTuple<uint32, int32>, uint32> ChartCopies;
+    for (int32 Index = 0; Index + 2 < Target.Indices.Num(); Index += 3) {
+        const int32 Charts[3] = {VertexCharts[Target.Indices[Index]], VertexCharts[Target.Indices[Index + 1]], VertexCharts[Target.Indices[Index + 2]]};
+        if (Charts[0] == Charts[1] && Charts[1] == Charts[2]) {
+            continue;
+        }
+
+        const int32 Chart = Charts[1] == Charts[2] ? Charts[1] : Charts[0];
+        for (int32 Corner = 0; Corner < 3; Corner++) {
+            if (Charts[Corner] == Chart) {
+                continue;
+            }
+
+            uint32& Vertex = Target.Indices[Index + Corner];
+            if (const uint32* Copy = ChartCopies.Find(MakeTuple(Vertex, Chart))) {
+                Vertex = *Copy;
+                continue;
+            }
+
+            const FVector Position  = Target.Positions[Vertex];
+            const FVector Normal    = Target.Normals[Vertex];
+            const uint32  NewVertex = Target.Positions.Num();
+            Target.Positions.Add(Position);
+            Target.Normals.Add(Normal);
+            Target.UVs.Add(Grid.FindUV(Position, Normal, Chart));
+            ChartCopies.Add(MakeTuple(Vertex, Chart), NewVertex);
+            Vertex = NewVertex;
+        }
+    }
+}
@@ -0,0 +1,17 @@
+// Copyright 1998-2019 Epic Games, Inc. All Rights Reserved.
+
+#pragma once
+
+#include "CoreMinimal.h"
+#include "GetModelObjWriter.h"
+
+/**
+ * Gives every vertex of Target the uv of the closest point on Source's surface, so a LOD can sample maps baked for
+ * another LOD of the same component. Triangles facing away from the vertex normal are only used when nothing facing
+ * the same way is close, which keeps back to back cards apart. Both meshes must be in the same space.
+ *
+ * A Target triangle whose corners land on different uv charts of Source keeps one chart, the other corners are
+ * duplicated with a uv on it. Where one such triangle covers the surface of several Source charts, its inside still
+ * samples only the chart it kept.
+ */
+void TransferUVs(const FGetModelMeshSnapshot& Source, FGetModelMeshSnapshot& Target);
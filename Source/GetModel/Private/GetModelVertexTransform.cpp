@@ -0,0 +1,90 @@
+// Copyright 1998-2019 Epic Games, Inc. All Rights Reserved.
+
+#include "GetModelVertexTransform.h"
+
+#include "Async/ParallelFor.h"
+
+namespace
+{
+const int32 BatchSize = 16 * 1024;
+
+struct FMatrixRows
+{
+    explicit FMatrixRows(const FMatrix& Matrix)
+        : X(VectorLoadAligned(Matrix.M[0]))
+        , Y(VectorLoadAligned(Matrix.M[1]))
+        , Z(VectorLoadAligned(Matrix.M[2]))
+        , W(VectorLoadAligned(Matrix.M[3]))
+    {
+    }
+
+    VectorRegister X;
+    VectorRegister Y;
+    VectorRegister Z;
+    VectorRegister W;
+};
+
+/** Transposed adjoint of Matrix, the inverse transpose up to 1 / determinant; only its sign matters before normalizing. */
+FMatrix GetNormalMatrix(const FMatrix& Matrix)
+{
+    return Matrix.TransposeAdjoint() * (Matrix.Determinant() < 0.0f ? -1.0f : 1.0f);
+}
+
+/** Transforms vertices [Begin, End) from In into Out, which may be the same arrays. */
+void TransformRange(const FMatrixRows& PositionRows, const FMatrixRows& NormalRows, const FVector* InPositions, const FVector* InNormals, FVector* OutPositions, FVector* OutNormals, int32 Begin, int32 End)
+{
+    const VectorRegister SmallSquared = VectorSetFloat1(SMALL_NUMBER);
+    const VectorRegister Zero         = VectorZero();
+
+    for (int32 i = Begin; i < End; i++) {
+        const VectorRegister P        = VectorLoadFloat3(&InPositions[i]);
+        VectorRegister       Position = VectorMultiplyAdd(VectorReplicate(P, 0), PositionRows.X, PositionRows.W);
+        Position                      = VectorMultiplyAdd(VectorReplicate(P, 1), PositionRows.Y, Position);
+        Position                      = VectorMultiplyAdd(VectorReplicate(P, 2), PositionRows.Z, Position);
+        VectorStoreFloat3(Position, &OutPositions[i]);
+
+        const VectorRegister N      = VectorLoadFloat3(&InNormals[i]);
+        VectorRegister       Normal = VectorMultiply(VectorReplicate(N, 0), NormalRows.X);
+        Normal                      = VectorMultiplyAdd(VectorReplicate(N, 1), NormalRows.Y, Normal);
+        Normal                      = VectorMultiplyAdd(VectorReplicate(N, 2), NormalRows.Z, Normal);
+
+        const VectorRegister LengthSquared = VectorDot3(Normal, Normal);
+        Normal                             = VectorSelect(VectorCompareGT(LengthSquared, SmallSquared), VectorMultiply(Normal, VectorReciprocalSqrtAccurate(LengthSquared)), Zero);
+        VectorStoreFloat3(Normal, &OutNormals[i]);
+    }
+}
+}  // namespace
+
+FMatrix GetObjSpaceSwizzle()
+{
+    return FMatrix(FPlane(1.0f, 0.0f, 0.0f, 0.0f), FPlane(0.0f, 0.0f, 1.0f, 0.0f), FPlane(0.0f, 1.0f, 0.0f, 0.0f), FPlane(0.0f, 0.0f, 0.0f, 1.0f));
+}
+
+void TransformVertices(const FMatrix& Matrix, FVector* Positions, FVector* Normals, int32 Count)
+{
+    const FMatrixRows PositionRows(Matrix);
+    const FMatrixRows NormalRows(GetNormalMatrix(Matrix));
+
+    ParallelFor(FMath::DivideAndRoundUp(Count, BatchSize), [&](int32 Batch) {
+        TransformRange(PositionRows, NormalRows, Positions, Normals, Positions, Normals, Batch * BatchSize, FMath::Min(Count, (Batch + 1) * BatchSize));
+    });
+}
+
+void TransformVertexCopies(const TArray<FMatrix>& Matrices, const FVector* Positions, const FVector* Normals, int32 Count, FVector* OutPositions, FVector* OutNormals)
+{
+    if (Count == 0) {
+        return;
+    }
+
+    // Small meshes take several copies per task so each task still covers about a batch of vertices.
+    const int32 CopiesPerTask = FMath::Max(1, BatchSize / Count);
+    ParallelFor(FMath::DivideAndRoundUp(Matrices.Num(), CopiesPerTask), [&](int32 Task) {
+        const int32 End = FMath::Min(Matrices.Num(), (Task + 1) * CopiesPerTask);
+        for (int32 Copy = Task * CopiesPerTask; Copy < End; Copy++) {
+            const FMatrixRows PositionRows(Matrices[Copy]);
+            const FMatrixRows NormalRows(GetNormalMatrix(Matrices[Copy]));
+            const int64       Offset = (int64)Copy * Count;
+            TransformRange(PositionRows, NormalRows, Positions, Normals, OutPositions + Offset, OutNormals + Offset, 0, Count);
+        }
+    });
+}
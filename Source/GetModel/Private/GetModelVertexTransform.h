@@ -0,0 +1,21 @@
+// Copyright 1998-2019 Epic Games, Inc. All Rights Reserved.
+
+#pragma once
+
+#include "CoreMinimal.h"
+
+/** Swaps Y and Z, from engine space into obj space and back. Compose it into the matrices given to TransformVertices. */
+FMatrix GetObjSpaceSwizzle();
+
+/**
+ * Transforms Count positions by Matrix and normals by its inverse transpose, renormalized, in place. Runs in
+ * parallel batches with VectorRegister math, so the axis swap and a full rotation, scale and translation cost the
+ * same as adding an offset. Degenerate normals come out as zero. Mirroring matrices leave the winding to the caller.
+ */
+void TransformVertices(const FMatrix& Matrix, FVector* Positions, FVector* Normals, int32 Count);
+
+/**
+ * Writes the Count positions and normals transformed by each of Matrices, one copy after another, into OutPositions
+ * and OutNormals, which hold Count * Matrices.Num() vertices. Copies of small meshes are grouped per task.
+ */
+void TransformVertexCopies(const TArray<FMatrix>& Matrices, const FVector* Positions, const FVector* Normals, int32 Count, FVector* OutPositions, FVector* OutNormals);
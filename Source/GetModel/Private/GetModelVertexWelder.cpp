@@ -0,0 +1,64 @@
+// Copyright 1998-2019 Epic Games, Inc. All Rights Reserved.
+
+#include "GetModelVertexWelder.h"
+
+#include "Async/ParallelFor.h"
+
+namespace
+{
+inline float SnapToGrid(float Value, float Epsilon)
+{
+    // + 0.0f folds -0.0 into 0.0 so both hash the same.
+    return (Epsilon > 0.0f ? FMath::RoundToFloat(Value / Epsilon) * Epsilon : Value) + 0.0f;
+}
+
+template <typename VectorType>
+VectorType SnapVector(const VectorType& Value, float Epsilon);
+
+template <>
+FVector SnapVector(const FVector& Value, float Epsilon)
+{
+    return FVector(SnapToGrid(Value.X, Epsilon), SnapToGrid(Value.Y, Epsilon), SnapToGrid(Value.Z, Epsilon));
+}
+
+template <>
+FVector2D SnapVector(const FVector2D& Value, float Epsilon)
+{
+    return FVector2D(SnapToGrid(Value.X, Epsilon), SnapToGrid(Value.Y, Epsilon));
+}
+
+template <typename VectorType>
+void WeldAttribute(TArrayView<const VectorType> Values, float Epsilon, TArray<VectorType>& OutUnique, TArray<uint32>& OutRemap)
+{
+    TMap<VectorType, uint32> UniqueIndices;
+    UniqueIndices.Reserve(Values.Num() / 2);
+
+    OutUnique.Reset();
+    OutRemap.SetNumUninitialized(Values.Num());
+    for (int32 i = 0; i < Values.Num(); i++) {
+        const VectorType Key = SnapVector(Values[i], Epsilon);
+        if (const uint32* Existing = UniqueIndices.Find(Key)) {
+            OutRemap[i] = *Existing;
+        } else {
+            OutRemap[i] = OutUnique.Add(Values[i]);
+            UniqueIndices.Add(Key, OutRemap[i]);
+        }
+    }
+}
+}  // namespace
+
+void WeldVertexAttributes(TArrayView<const FVector> Positions, TArrayView<const FVector2D> UVs, TArrayView<const FVector> Normals, const FGetModelWeldSettings& Settings, FGetModelWeldedMesh& OutMesh)
+{
+    check(Positions.Num() == UVs.Num() && Positions.Num() == Normals.Num());
+
+    // The three attributes do not depend on each other.
+    ParallelFor(3, [&](int32 Attribute) {
+        if (Attribute == 0) {
+            WeldAttribute(Positions, Settings.PositionEpsilon, OutMesh.Positions, OutMesh.PositionRemap);
+        } else if (Attribute == 1) {
+            WeldAttribute(UVs, Settings.UVEpsilon, OutMesh.UVs, OutMesh.UVRemap);
+        } else {
+            WeldAttribute(Normals, Settings.NormalEpsilon, OutMesh.Normals, OutMesh.NormalRemap);
+        }
+    });
+}
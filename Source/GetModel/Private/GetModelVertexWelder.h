@@ -0,0 +1,31 @@
+// Copyright 1998-2019 Epic Games, Inc. All Rights Reserved.
+
+#pragma once
+
+#include "CoreMinimal.h"
+
+/** Tolerances used to merge attribute values, 0 only merges bit-identical values. */
+struct FGetModelWeldSettings
+{
+    float PositionEpsilon = 0.01f;
+    float UVEpsilon       = 1.0e-5f;
+    float NormalEpsilon   = 1.0e-3f;
+};
+
+/** Unique positions, uvs and normals of a render mesh plus, per render vertex, the index of each of its attributes. */
+struct FGetModelWeldedMesh
+{
+    TArray<FVector>   Positions;
+    TArray<FVector2D> UVs;
+    TArray<FVector>   Normals;
+
+    TArray<uint32> PositionRemap;
+    TArray<uint32> UVRemap;
+    TArray<uint32> NormalRemap;
+};
+
+/**
+ * Welds each attribute on its own: values are snapped to an epsilon grid and hashed, the first value seen in a cell is
+ * kept. Render vertices split on uv seams or hard edges therefore share one position.
+ */
+void WeldVertexAttributes(TArrayView<const FVector> Positions, TArrayView<const FVector2D> UVs, TArrayView<const FVector> Normals, const FGetModelWeldSettings& Settings, FGetModelWeldedMesh& OutMesh);
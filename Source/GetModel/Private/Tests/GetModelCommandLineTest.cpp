@@ -0,0 +1,48 @@
+// Copyright 1998-2019 Epic Games, Inc. All Rights Reserved.
+
+#include "CoreMinimal.h"
+#include "GetModelBenchmarkCommandlet.h"
+#include "GetModelExportSettings.h"
+#include "Misc/AutomationTest.h"
+
+#if WITH_DEV_AUTOMATION_TESTS
+
+/**
+ * Switches that contain a shorter one (-TextureFormat= and -Format=, -Actors= and -InstancingMultiActors=...) must
+ * only set their own value, and config lines must not override the command line, one with spaces in its value.
+ */
+IMPLEMENT_SIMPLE_AUTOMATION_TEST(FGetModelOverlappingSwitchesTest, "GetModel.CommandLine.OverlappingSwitches", EAutomationTestFlags::EditorContext | EAutomationTestFlags::EngineFilter)
+
+bool FGetModelOverlappingSwitchesTest::RunTest(const FString& Parameters)
+{
+    const FString Params = AppendConfigLines(TEXT("-TextureFormat=png -NormalMapFormat=tga -Format=glb -InstancingMultiActors=false -LandscapeWeightmaps=true -MinLODTextureSize=32 -TextureSize=512 -Maps=/Game/A -Actors=Rock*"),
+                                             {TEXT("TextureSize=256"), TEXT("OutputDir=D:/My Exports"), TEXT("; Format=obj")});
+
+    FGetModelExportSettings Settings;
+    Settings.ParseCommandLine(*Params);
+
+    TestTrue(TEXT("Format"), Settings.Format == EGetModelExportFormat::Glb);
+    TestTrue(TEXT("TextureFormat"), Settings.TextureFormat == EGetModelTextureFormat::PNG);
+    TestTrue(TEXT("NormalMapFormat"), Settings.NormalMapFormat == EGetModelTextureFormat::TGA);
+    TestFalse(TEXT("InstancingMultiActors"), Settings.bInstancingMultiActors);
+    TestTrue(TEXT("LandscapeWeightmaps"), Settings.bLandscapeWeightmaps);
+    TestEqual(TEXT("MinLODTextureSize"), Settings.MinLODTextureSize, 32);
+    TestTrue(TEXT("TextureSize"), Settings.TextureSize == FIntPoint(512, 512));
+    TestTrue(TEXT("Maps"), ParseList(Params, TEXT("-Maps=")) == TArray<FString>{TEXT("/Game/A")});
+    TestTrue(TEXT("Actors"), ParseList(Params, TEXT("-Actors=")) == TArray<FString>{TEXT("Rock*")});
+    TestEqual(TEXT("ActorTags"), ParseList(Params, TEXT("-ActorTags=")).Num(), 0);
+    TestEqual(TEXT("OutputDir"), Settings.OutputDir, FString(TEXT("D:/My Exports")));
+
+    const FString             BenchmarkParams = TEXT("-TestCases=1x1 -Cases=5x2 -MaxIterations=9 -Iterations=2 -MyReport=A.csv -Report=B.csv -NoBaseline=C.csv -Baseline=D.csv -LowThreshold=0.9 -Threshold=0.1");
+    FGetModelBenchmarkOptions BenchmarkOptions;
+    BenchmarkOptions.ParseCommandLine(*BenchmarkParams);
+
+    TestEqual(TEXT("Cases"), BenchmarkOptions.Cases, FString(TEXT("5x2")));
+    TestEqual(TEXT("Iterations"), BenchmarkOptions.Iterations, 2);
+    TestEqual(TEXT("Report"), BenchmarkOptions.ReportPath, FString(TEXT("B.csv")));
+    TestEqual(TEXT("Baseline"), BenchmarkOptions.BaselinePath, FString(TEXT("D.csv")));
+    TestEqual(TEXT("Threshold"), BenchmarkOptions.Threshold, 0.1f, KINDA_SMALL_NUMBER);
+    return true;
+}
+
+#endif  // WITH_DEV_AUTOMATION_TESTS
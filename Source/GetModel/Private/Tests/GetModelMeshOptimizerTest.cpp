@@ -0,0 +1,79 @@
+// Copyright 1998-2019 Epic Games, Inc. All Rights Reserved.
+
+#include "CoreMinimal.h"
+#include "GetModelMeshOptimizer.h"
+#include "Misc/AutomationTest.h"
+
+#if WITH_DEV_AUTOMATION_TESTS
+
+namespace
+{
+/** A triangle as its original vertex ids, rotated to start at the lowest so the winding is kept. */
+FIntVector GetSortedTriangle(const FGetModelMeshSnapshot& Mesh, int32 Triangle)
+{
+    int32 Corners[3];
+    for (int32 Corner = 0; Corner < 3; Corner++) {
+        Corners[Corner] = FMath::RoundToInt(Mesh.Positions[Mesh.Indices[3 * Triangle + Corner]].X);
+    }
+    const int32 First = Corners[0] <= FMath::Min(Corners[1], Corners[2]) ? 0 : (Corners[1] <= Corners[2] ? 1 : 2);
+    return FIntVector(Corners[First], Corners[(First + 1) % 3], Corners[(First + 2) % 3]);
+}
+
+/** The triangles of each material range, sorted so ranges compare regardless of their order. */
+TArray<TArray<FIntVector>> GetRanges(const FGetModelMeshSnapshot& Mesh)
+{
+    TArray<TArray<FIntVector>> Ranges;
+    Ranges.SetNum(Mesh.MaterialTriangles.Num());
+    for (int32 Triangle = 0; Triangle < Mesh.Indices.Num() / 3; Triangle++) {
+        Ranges[Triangle < Mesh.MaterialTriangles[1] ? 0 : 1].Add(GetSortedTriangle(Mesh, Triangle));
+    }
+    for (TArray<FIntVector>& Range : Ranges) {
+        Range.Sort([](const FIntVector& A, const FIntVector& B) { return A.X != B.X ? A.X < B.X : (A.Y != B.Y ? A.Y < B.Y : A.Z < B.Z); });
+    }
+    return Ranges;
+}
+}  // namespace
+
+/** The optimizer must only reorder triangles within their material range, degenerate ones included. */
+IMPLEMENT_SIMPLE_AUTOMATION_TEST(FGetModelMeshOptimizerKeepsTrianglesTest, "GetModel.MeshOptimizer.KeepsTriangles", EAutomationTestFlags::EditorContext | EAutomationTestFlags::EngineFilter)
+
+bool FGetModelMeshOptimizerKeepsTrianglesTest::RunTest(const FString& Parameters)
+{
+    // A grid whose vertices store their id in X, with triangles collapsed to an edge or a point among its quads.
+    const int32           GridSize = 8;
+    FGetModelMeshSnapshot Mesh;
+    for (int32 Vertex = 0; Vertex < (GridSize + 1) * (GridSize + 1); Vertex++) {
+        Mesh.Positions.Add(FVector(Vertex, 0.0f, 0.0f));
+        Mesh.Normals.Add(FVector::UpVector);
+        Mesh.UVs.Add(FVector2D::ZeroVector);
+    }
+    for (int32 Y = 0; Y < GridSize; Y++) {
+        for (int32 X = 0; X < GridSize; X++) {
+            const uint32 I00 = Y * (GridSize + 1) + X;
+            const uint32 I10 = I00 + 1;
+            const uint32 I01 = I00 + GridSize + 1;
+            const uint32 I11 = I01 + 1;
+            Mesh.Indices.Append({I00, I11, I10, I00, I01, I11});
+            if ((X + Y) % 3 == 0) {
+                Mesh.Indices.Append({I00, I00, I11, I10, I11, I11, I01, I01, I01});
+            }
+        }
+    }
+    Mesh.MaterialTriangles = {0, Mesh.Indices.Num() / 6};
+    Mesh.MaterialNames     = {TEXT("First"), TEXT("Second")};
+
+    const TArray<TArray<FIntVector>> Expected = GetRanges(Mesh);
+
+    FGetModelOptimizeSettings OptimizeSettings;
+    OptimizeSettings.bOverdraw = true;
+    OptimizeMeshSnapshot(Mesh, OptimizeSettings);
+
+    const TArray<TArray<FIntVector>> Optimized = GetRanges(Mesh);
+    TestEqual(TEXT("Material ranges"), Optimized.Num(), Expected.Num());
+    for (int32 Range = 0; Range < FMath::Min(Expected.Num(), Optimized.Num()); Range++) {
+        TestTrue(FString::Printf(TEXT("%s keeps its triangles"), *Mesh.MaterialNames[Range]), Optimized[Range] == Expected[Range]);
+    }
+    return true;
+}
+
+#endif  // WITH_DEV_AUTOMATION_TESTS
@@ -7,6 +7,22 @@
 
 class FToolBarBuilder;
 class FMenuBuilder;
+struct FGetModelWeldSettings;
+struct FGetModelMeshSnapshot;
+struct FGetModelMapExport;
+struct FGetModelExportSettings;
+enum class EGetModelTextureFormat : uint8;
+
+/** File format written by "Export obj And mtl" / "Export glb" / "Export gmq". */
+enum class EGetModelExportFormat : uint8
+{
+    Obj,
+    Glb,
+    /** Quantized, compressed binary mesh with an mtl and maps like obj (see GetModelQuantizedWriter.h). */
+    Gmq,
+};
+
+DECLARE_LOG_CATEGORY_EXTERN(LogGetModel, Log, All);
 
 class FGetModelModule : public IModuleInterface
 {
@@ -20,9 +36,17 @@ public:
 
     FReply                 GenerateMergeObj();
     FReply                 ExportMergeObj();
-    void                   GetObjandMaterialMethod(bool bExport);
-    TMap<FString, FString> ExportMaterialToBMP(TArray<UObject*>& ObjectsToExport);
-    TArray<FString>        ExportObj(UStaticMesh* MergedMesh, FString& ObjPath, int LOD_index, UStaticMeshComponent* StaticMeshComponent);
+    FReply                 ExportMergeGlb();
+    FReply                 ExportMergeGmq();
+    void                   GetObjandMaterialMethod(bool bExport, EGetModelExportFormat Format = EGetModelExportFormat::Obj);
+    void                   ExportActors(TArray<AActor*> Actors, const FGetModelExportSettings& Settings);
+    int32                  ExportComponents(const TArray<UPrimitiveComponent*>& Components, const FGetModelExportSettings& Settings, TArray<UObject*>* OutMergedAssets = nullptr);
+    TMap<FString, FString> ExportMaterialToBMP(TArray<UObject*>& ObjectsToExport, EGetModelTextureFormat Format, EGetModelTextureFormat NormalFormat, const FString& SavePath = FString());
+    void                   GatherMaterialMaps(TArray<UObject*>& ObjectsToExport, EGetModelTextureFormat Format, EGetModelTextureFormat NormalFormat, const FString& SavePath, FGetModelMapExport& OutMaps);
+    TArray<FString>        ExportObj(UStaticMesh* MergedMesh, FString& ObjPath, int LOD_index, UStaticMeshComponent* StaticMeshComponent, int32 FloatPrecision = 6, const FGetModelWeldSettings* WeldSettings = nullptr);
+    void                   SnapshotMesh(UStaticMesh* MergedMesh, int LOD_index, UStaticMeshComponent* StaticMeshComponent, FGetModelMeshSnapshot& OutMesh);
+    void                   SnapshotMesh(UStaticMesh* Mesh, int LOD_index, const FMatrix& MeshToWorld, FGetModelMeshSnapshot& OutMesh);
+    bool                   ExportGlb(UStaticMesh* MergedMesh, const FString& GlbPath, int LOD_index, UStaticMeshComponent* StaticMeshComponent, TArray<UObject*>& BakedAssets);
 
 private:
     void AddToolbarExtension(FToolBarBuilder& Builder);
@@ -31,5 +55,6 @@ private:
     TSharedRef<class SDockTab> OnSpawnPluginTab(const class FSpawnTabArgs& SpawnTabArgs);
 
 private:
-    TSharedPtr<class FUICommandList> PluginCommands;
+    TSharedPtr<class FUICommandList>            PluginCommands;
+    TSharedPtr<class FGetModelExporterRegistry> ExporterRegistry;
 };
@@ -0,0 +1,148 @@
+// Copyright 1998-2019 Epic Games, Inc. All Rights Reserved.
+
+// Micro-benchmark of the obj formatting hot loop on synthetic grids, the native counterpart of -run=GetModelBenchmark:
+//
+//   GetModelObjBench [vertices ...] [-precision N] [-iterations N] [-sections N]
+//
+// Prints the best of the iterations per case for the float formatter alone and for whole files.
+
+#include "GetModelObjFormat.h"
+#include "GetModelObjTextBuffer.h"
+
+#include <chrono>
+#include <cmath>
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include <string>
+#include <vector>
+
+namespace
+{
+struct FGridMesh
+{
+    std::vector<float>       Positions;
+    std::vector<float>       UVs;
+    std::vector<float>       Normals;
+    std::vector<uint32_t>    Indices;
+    std::vector<int32_t>     MaterialTriangles;
+    std::vector<std::string> MaterialNames;
+    std::vector<const char*> MaterialNamePointers;
+
+    GetModelObj::FMeshView GetView() const
+    {
+        GetModelObj::FMeshView View;
+        View.Positions         = Positions.data();
+        View.NumPositions      = (int32_t)Positions.size() / 3;
+        View.UVs               = UVs.data();
+        View.NumUVs            = (int32_t)UVs.size() / 2;
+        View.Normals           = Normals.data();
+        View.NumNormals        = (int32_t)Normals.size() / 3;
+        View.Indices           = Indices.data();
+        View.NumIndices        = (int32_t)Indices.size();
+        View.MaterialTriangles = MaterialTriangles.data();
+        View.MaterialNames     = MaterialNamePointers.data();
+        View.NumMaterials      = (int32_t)MaterialTriangles.size();
+        return View;
+    }
+};
+
+// Same displaced grid the GetModelBenchmark commandlet builds, cut into sections by rows.
+FGridMesh BuildGrid(int32_t NumVertices, int32_t NumSections)
+{
+    const int32_t Side = std::max(NumSections + 1, (int32_t)std::ceil(std::sqrt((double)NumVertices)));
+
+    FGridMesh Mesh;
+    Mesh.Positions.reserve(Side * Side * 3);
+    Mesh.UVs.reserve(Side * Side * 2);
+    Mesh.Normals.reserve(Side * Side * 3);
+    for (int32_t Y = 0; Y < Side; Y++) {
+        for (int32_t X = 0; X < Side; X++) {
+            const float Height = std::sin(X * 0.1f) * std::cos(Y * 0.1f) * 50.0f;
+            const float NX     = -std::cos(X * 0.1f);
+            const float NY     = -std::sin(Y * 0.1f);
+            const float Length = std::sqrt(NX * NX + NY * NY + 1.0f);
+            Mesh.Positions.insert(Mesh.Positions.end(), {X * 10.0f, Height, Y * 10.0f});
+            Mesh.UVs.insert(Mesh.UVs.end(), {(float)X / (Side - 1), 1.0f - (float)Y / (Side - 1)});
+            Mesh.Normals.insert(Mesh.Normals.end(), {NX / Length, 1.0f / Length, NY / Length});
+        }
+    }
+
+    Mesh.Indices.reserve((Side - 1) * (Side - 1) * 6);
+    for (int32_t Y = 0; Y < Side - 1; Y++) {
+        const int32_t Section = Y * NumSections / (Side - 1);
+        if (Mesh.MaterialTriangles.empty() || Section != (int32_t)Mesh.MaterialTriangles.size() - 1) {
+            Mesh.MaterialTriangles.push_back((int32_t)Mesh.Indices.size() / 3);
+            Mesh.MaterialNames.push_back("Section" + std::to_string(Section) + "_Section" + std::to_string(Section));
+        }
+        for (int32_t X = 0; X < Side - 1; X++) {
+            const uint32_t Corner = Y * Side + X;
+            Mesh.Indices.insert(Mesh.Indices.end(), {Corner, Corner + Side, Corner + 1, Corner + 1, Corner + Side, Corner + Side + 1});
+        }
+    }
+    for (const std::string& Name : Mesh.MaterialNames) {
+        Mesh.MaterialNamePointers.push_back(Name.c_str());
+    }
+    return Mesh;
+}
+
+template <typename Func>
+double BestSeconds(int32_t Iterations, Func Body)
+{
+    double Best = 1.0e30;
+    for (int32_t Iteration = 0; Iteration < Iterations; Iteration++) {
+        const auto Start = std::chrono::steady_clock::now();
+        Body();
+        Best = std::min(Best, std::chrono::duration<double>(std::chrono::steady_clock::now() - Start).count());
+    }
+    return Best;
+}
+}  // namespace
+
+int main(int argc, char** argv)
+{
+    std::vector<int32_t> Cases;
+    int32_t              Precision   = 6;
+    int32_t              Iterations  = 5;
+    int32_t              NumSections = 8;
+    for (int32_t Arg = 1; Arg < argc; Arg++) {
+        if (!std::strcmp(argv[Arg], "-precision") && Arg + 1 < argc) {
+            Precision = std::atoi(argv[++Arg]);
+        } else if (!std::strcmp(argv[Arg], "-iterations") && Arg + 1 < argc) {
+            Iterations = std::max(1, std::atoi(argv[++Arg]));
+        } else if (!std::strcmp(argv[Arg], "-sections") && Arg + 1 < argc) {
+            NumSections = std::max(1, std::atoi(argv[++Arg]));
+        } else {
+            Cases.push_back(std::atoi(argv[Arg]));
+        }
+    }
+    if (Cases.empty()) {
+        Cases = {10000, 100000, 1000000};
+    }
+
+    std::printf("%-10s %-9s %12s %14s %10s %12s\n", "Vertices", "Stage", "Seconds", "Items/s", "MB/s", "Bytes");
+    for (int32_t NumVertices : Cases) {
+        const FGridMesh              Mesh = BuildGrid(NumVertices, NumSections);
+        const GetModelObj::FMeshView View = Mesh.GetView();
+        FGetModelObjTextBuffer       Buffer;
+
+        // Floats alone, the bulk of every obj file.
+        const int32_t NumFloats    = (int32_t)Mesh.Positions.size();
+        const double  FloatSeconds = BestSeconds(Iterations, [&]() {
+            Buffer.Reset();
+            for (int32_t i = 0; i < NumFloats; i++) {
+                char* Out = GetModelObj::WriteFloat(Buffer.Reserve(GetModelObj::MaxFloatChars + 1), Mesh.Positions[i], Precision);
+                *Out++    = ' ';
+                Buffer.Commit(Out);
+            }
+        });
+        std::printf("%-10d %-9s %12.4f %14.0f %10.1f %12zu\n", View.NumPositions, "floats", FloatSeconds, NumFloats / FloatSeconds, Buffer.Num() / (1024.0 * 1024.0) / FloatSeconds, Buffer.Num());
+
+        const double ObjSeconds = BestSeconds(Iterations, [&]() {
+            Buffer.Reset();
+            GetModelObj::AppendObj(Buffer, View, "Bench.mtl", Precision);
+        });
+        std::printf("%-10d %-9s %12.4f %14.0f %10.1f %12zu\n", View.NumPositions, "obj", ObjSeconds, View.NumPositions / ObjSeconds, Buffer.Num() / (1024.0 * 1024.0) / ObjSeconds, Buffer.Num());
+    }
+    return 0;
+}
@@ -0,0 +1,305 @@
+// Copyright 1998-2019 Epic Games, Inc. All Rights Reserved.
+
+// Fuzzes the obj formatting core and the mesh stream codec. Every input is read as a precision, raw floats and a small
+// mesh, and checked for:
+//   - fixed precision floats matching printf "%.*f" byte for byte, shortest floats reading back to the same value
+//     with no fewer "%.*g" digits doing so;
+//   - no call writing more than its Max*Chars bound;
+//   - a file formatted range by range being identical to the same file formatted in one go;
+//   - vertex and index streams decoding back to what was encoded, within the Get*StreamBound sizes, and damaged
+//     streams being rejected or decoded without reading past their end.
+//
+//   GetModelObjFuzz [runs] [seed]     built-in random driver
+//   GetModelObjFuzz corpus/ -runs=N   with -DGETMODEL_LIBFUZZER=ON
+
+#include "GetModelMeshCodec.h"
+#include "GetModelObjFormat.h"
+#include "GetModelObjTextBuffer.h"
+
+#include <cmath>
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include <random>
+#include <string>
+#include <vector>
+
+namespace
+{
+void Fail(const char* What, float Value, int32_t Precision, const char* Text, size_t Length)
+{
+    std::fprintf(stderr, "%s: value %a precision %d wrote '%.*s'\n", What, Value, Precision, (int)Length, Text);
+    std::abort();
+}
+
+/** Significant digits of a "%g" style number. */
+int32_t CountDigits(const std::string& Text)
+{
+    int32_t Count    = 0;
+    bool    bLeading = true;
+    for (char Char : Text) {
+        if (Char == 'e') {
+            break;
+        }
+        if (Char >= '1' && Char <= '9') {
+            bLeading = false;
+        }
+        if (Char >= '0' && Char <= '9' && !bLeading) {
+            Count++;
+        }
+    }
+    return Count;
+}
+
+void CheckFloat(float Value, int32_t Precision)
+{
+    char         Text[GetModelObj::MaxFloatChars + 1];
+    const char*  End    = GetModelObj::WriteFloat(Text, Value, Precision);
+    const size_t Length = End - Text;
+    if (Length >= (size_t)GetModelObj::MaxFloatChars) {
+        Fail("float longer than MaxFloatChars", Value, Precision, Text, Length);
+    }
+
+    if (Precision >= 0) {
+        char          Expected[GetModelObj::MaxFloatChars + 1];
+        const int32_t ExpectedLength = std::snprintf(Expected, sizeof(Expected), "%.*f", GetModelObj::ClampPrecision(Precision), Value);
+        if ((size_t)ExpectedLength != Length || std::memcmp(Expected, Text, Length)) {
+            Fail("fixed float differs from printf", Value, Precision, Text, Length);
+        }
+    } else if (!std::isnan(Value)) {
+        const std::string Copy(Text, Length);
+        const float       ReadBack = (float)std::strtod(Copy.c_str(), nullptr);
+        if (ReadBack != Value || std::signbit(ReadBack) != std::signbit(Value)) {
+            Fail("shortest float does not read back", Value, Precision, Text, Length);
+        }
+
+        char          Shorter[GetModelObj::MaxFloatChars + 1];
+        const int32_t Digits = CountDigits(Copy);
+        if (std::isfinite(Value) && Digits > 1) {
+            // At most 8 digits here, so this never truncates; the check keeps -Wformat-truncation quiet.
+            const int32_t ShorterLength = std::snprintf(Shorter, sizeof(Shorter), "%.*g", Digits - 1, Value);
+            if (ShorterLength < (int32_t)sizeof(Shorter) && (float)std::strtod(Shorter, nullptr) == Value) {
+                Fail("shortest float has more digits than needed", Value, Precision, Text, Length);
+            }
+        }
+    }
+}
+
+/** Consumes the input front to back, running out yields zeros. */
+class FInput
+{
+public:
+    FInput(const uint8_t* InData, size_t InSize)
+        : Data(InData)
+        , Size(InSize)
+    {
+    }
+
+    template <typename T>
+    T Read()
+    {
+        T Value{};
+        const size_t Count = std::min(sizeof(T), Size - Offset);
+        std::memcpy(&Value, Data + Offset, Count);
+        Offset += Count;
+        return Value;
+    }
+
+private:
+    const uint8_t* Data;
+    size_t         Size;
+    size_t         Offset = 0;
+};
+
+void CheckMesh(FInput& Input, int32_t Precision)
+{
+    const int32_t NumVertices  = 1 + Input.Read<uint8_t>() % 64;
+    const int32_t NumTriangles = Input.Read<uint8_t>() % 128;
+    const bool    bRemap       = Input.Read<uint8_t>() & 1;
+
+    std::vector<float> Positions(NumVertices * 3);
+    std::vector<float> UVs(NumVertices * 2);
+    std::vector<float> Normals(NumVertices * 3);
+    for (float& Value : Positions) {
+        Value = Input.Read<float>();
+    }
+    for (float& Value : UVs) {
+        Value = Input.Read<float>();
+    }
+    for (float& Value : Normals) {
+        Value = Input.Read<float>();
+    }
+
+    std::vector<uint32_t> Indices(NumTriangles * 3);
+    for (uint32_t& Index : Indices) {
+        Index = Input.Read<uint8_t>() % NumVertices;
+    }
+
+    // Welded output: each render vertex points at any one of the attribute values.
+    std::vector<uint32_t> Remap(NumVertices);
+    for (uint32_t& Index : Remap) {
+        Index = Input.Read<uint8_t>() % NumVertices;
+    }
+
+    std::vector<int32_t>     MaterialTriangles;
+    std::vector<std::string> MaterialNames;
+    for (int32_t Triangle = 0; Triangle < NumTriangles; Triangle++) {
+        if (Input.Read<uint8_t>() < 32) {
+            MaterialTriangles.push_back(Triangle);
+            MaterialNames.push_back("M" + std::to_string(Triangle));
+        }
+    }
+    std::vector<const char*> MaterialNamePointers;
+    for (const std::string& Name : MaterialNames) {
+        MaterialNamePointers.push_back(Name.c_str());
+    }
+
+    GetModelObj::FMeshView View;
+    View.Positions         = Positions.data();
+    View.NumPositions      = NumVertices;
+    View.UVs               = UVs.data();
+    View.NumUVs            = NumVertices;
+    View.Normals           = Normals.data();
+    View.NumNormals        = NumVertices;
+    View.Indices           = Indices.data();
+    View.NumIndices        = (int32_t)Indices.size();
+    View.PositionRemap     = bRemap ? Remap.data() : nullptr;
+    View.UVRemap           = bRemap ? Remap.data() : nullptr;
+    View.NormalRemap       = bRemap ? Remap.data() : nullptr;
+    View.MaterialTriangles = MaterialTriangles.data();
+    View.MaterialNames     = MaterialNamePointers.data();
+    View.NumMaterials      = (int32_t)MaterialTriangles.size();
+
+    FGetModelObjTextBuffer Whole;
+    GetModelObj::AppendObj(Whole, View, "Fuzz.mtl", Precision);
+
+    // Same blocks cut into ranges of RangeSize items, like FGetModelObjWriter::ParallelAppend does.
+    const int32_t          RangeSize = 1 + Input.Read<uint8_t>() % 16;
+    FGetModelObjTextBuffer Ranged;
+    GetModelObj::AppendHeader(Ranged, "Fuzz.mtl");
+    for (int32_t Begin = 0; Begin < NumVertices; Begin += RangeSize) {
+        GetModelObj::AppendPositions(Ranged, View, Begin, std::min(Begin + RangeSize, NumVertices), Precision);
+    }
+    GetModelObj::AppendText(Ranged, "\r\n", 2);
+    for (int32_t Begin = 0; Begin < NumVertices; Begin += RangeSize) {
+        GetModelObj::AppendTexCoords(Ranged, View, Begin, std::min(Begin + RangeSize, NumVertices), Precision);
+    }
+    GetModelObj::AppendText(Ranged, "\r\n", 2);
+    for (int32_t Begin = 0; Begin < NumVertices; Begin += RangeSize) {
+        GetModelObj::AppendNormals(Ranged, View, Begin, std::min(Begin + RangeSize, NumVertices), Precision);
+    }
+    for (int32_t Begin = 0; Begin < NumTriangles; Begin += RangeSize) {
+        GetModelObj::AppendFaces(Ranged, View, Begin, std::min(Begin + RangeSize, NumTriangles));
+    }
+    GetModelObj::AppendFooter(Ranged);
+
+    if (Whole.Num() != Ranged.Num() || std::memcmp(Whole.GetData(), Ranged.GetData(), Whole.Num())) {
+        std::fprintf(stderr, "ranged output differs from whole output (range size %d)\n", RangeSize);
+        std::abort();
+    }
+}
+
+void CheckCodec(FInput& Input)
+{
+    const size_t NumVertices = Input.Read<uint16_t>() % 1024;
+    const size_t Stride      = 1 + Input.Read<uint8_t>() % 16;
+    const size_t NumIndices  = Input.Read<uint8_t>() * 3;
+
+    // Mostly small steps so every group width shows up, with the odd large jump.
+    std::vector<uint8_t> Vertices(NumVertices * Stride);
+    for (size_t i = 0; i < Vertices.size(); i++) {
+        const uint8_t Step = Input.Read<uint8_t>();
+        Vertices[i]        = (uint8_t)((i >= Stride ? Vertices[i - Stride] : 0) + (Step < 224 ? Step % 5 : Step));
+    }
+    std::vector<uint32_t> Indices(NumIndices);
+    for (uint32_t& Index : Indices) {
+        Index = Input.Read<uint8_t>() < 16 ? Input.Read<uint32_t>() : Input.Read<uint8_t>() % std::max<size_t>(NumVertices, 1);
+    }
+
+    std::vector<uint8_t> Encoded(GetModelCodec::GetVertexStreamBound(NumVertices, Stride));
+    const size_t         VertexBytes = GetModelCodec::EncodeVertexStream(Encoded.data(), Vertices.data(), NumVertices, Stride);
+    if (VertexBytes > Encoded.size()) {
+        std::fprintf(stderr, "vertex stream longer than its bound\n");
+        std::abort();
+    }
+    std::vector<uint8_t> Decoded(Vertices.size());
+    if (!GetModelCodec::DecodeVertexStream(Decoded.data(), NumVertices, Stride, Encoded.data(), VertexBytes) || Decoded != Vertices) {
+        std::fprintf(stderr, "vertex stream does not decode back (%zu vertices, stride %zu)\n", NumVertices, Stride);
+        std::abort();
+    }
+
+    std::vector<uint8_t> EncodedIndices(GetModelCodec::GetIndexStreamBound(NumIndices));
+    const size_t         IndexBytes = GetModelCodec::EncodeIndexStream(EncodedIndices.data(), Indices.data(), NumIndices);
+    if (IndexBytes > EncodedIndices.size()) {
+        std::fprintf(stderr, "index stream longer than its bound\n");
+        std::abort();
+    }
+    std::vector<uint32_t> DecodedIndices(NumIndices);
+    if (!GetModelCodec::DecodeIndexStream(DecodedIndices.data(), NumIndices, EncodedIndices.data(), IndexBytes) || DecodedIndices != Indices) {
+        std::fprintf(stderr, "index stream does not decode back (%zu indices)\n", NumIndices);
+        std::abort();
+    }
+
+    // Truncated or flipped streams: the result does not matter, only that decoding stays inside the data.
+    if (VertexBytes) {
+        std::vector<uint8_t> Damaged(Encoded.begin(), Encoded.begin() + VertexBytes);
+        Damaged[Input.Read<uint16_t>() % VertexBytes] ^= 1 + Input.Read<uint8_t>() % 255;
+        GetModelCodec::DecodeVertexStream(Decoded.data(), NumVertices, Stride, Damaged.data(), Damaged.size() - Input.Read<uint8_t>() % 2);
+    }
+    if (IndexBytes) {
+        std::vector<uint8_t> Damaged(EncodedIndices.begin(), EncodedIndices.begin() + IndexBytes - 1);
+        GetModelCodec::DecodeIndexStream(DecodedIndices.data(), NumIndices, Damaged.data(), Damaged.size());
+    }
+}
+
+void RunOne(const uint8_t* Data, size_t Size)
+{
+    FInput        Input(Data, Size);
+    const int32_t Precision = (int32_t)(Input.Read<uint8_t>() % 12) - 1;
+
+    const int32_t NumFloats = Input.Read<uint8_t>() % 32;
+    for (int32_t i = 0; i < NumFloats; i++) {
+        const float Value = Input.Read<float>();
+        CheckFloat(Value, Precision);
+        CheckFloat(Value, -1);
+    }
+
+    CheckMesh(Input, Precision);
+    CheckCodec(Input);
+}
+}  // namespace
+
+#ifdef GETMODEL_LIBFUZZER
+extern "C" int LLVMFuzzerTestOneInput(const uint8_t* Data, size_t Size)
+{
+    RunOne(Data, Size);
+    return 0;
+}
+#else
+int main(int argc, char** argv)
+{
+    const long     Runs = argc > 1 ? std::atol(argv[1]) : 10000;
+    const uint32_t Seed = argc > 2 ? (uint32_t)std::atol(argv[2]) : 1;
+
+    // Half the inputs are raw bytes, the other half floats of a realistic magnitude so the fast path gets most of the work.
+    std::mt19937                          Random(Seed);
+    std::uniform_int_distribution<int>    Byte(0, 255);
+    std::uniform_real_distribution<float> Coordinate(-1.0e6f, 1.0e6f);
+    std::vector<uint8_t>                  Data;
+    for (long Run = 0; Run < Runs; Run++) {
+        Data.resize(Byte(Random) * 16);
+        for (size_t i = 0; i < Data.size(); i++) {
+            Data[i] = (uint8_t)Byte(Random);
+        }
+        if (Run & 1) {
+            for (size_t i = 2; i + sizeof(float) <= Data.size(); i += sizeof(float)) {
+                const float Value = Coordinate(Random) / (float)(1 << (Byte(Random) % 24));
+                std::memcpy(&Data[i], &Value, sizeof(float));
+            }
+        }
+        RunOne(Data.data(), Data.size());
+    }
+    std::printf("%ld runs passed\n", Runs);
+    return 0;
+}
+#endif
@@ -0,0 +1,37 @@
+// Copyright 1998-2019 Epic Games, Inc. All Rights Reserved.
+
+#pragma once
+
+#include <algorithm>
+#include <cstdint>
+#include <vector>
+
+/** std::vector counterpart of FGetModelObjBuffer for the native tools. */
+class FGetModelObjTextBuffer
+{
+public:
+    char* Reserve(int32_t MaxChars)
+    {
+        if (Size + MaxChars > Data.size()) {
+            Data.resize(std::max(Data.size() * 2, Size + MaxChars));
+        }
+        return Data.data() + Size;
+    }
+
+    void Commit(char* End)
+    {
+        Size = End - Data.data();
+    }
+
+    void Reset()
+    {
+        Size = 0;
+    }
+
+    const char* GetData() const { return Data.data(); }
+    size_t      Num() const { return Size; }
+
+private:
+    std::vector<char> Data;
+    size_t            Size = 0;
+};